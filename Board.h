@@ -0,0 +1,279 @@
+#ifndef MINE_SWEEPER_BOARD_H
+#define MINE_SWEEPER_BOARD_H
+
+#include <QQueue>
+#include <utility>
+#include "BoardState.h"
+#include "Frontier.h"
+#include "Topology.h"
+
+/**
+ * @brief The BasicBoard class adds the rules that walk neighborhoods, for one topology
+ * Every move also updates the board's frontier incrementally
+ * @tparam Topology Policy from Topology.h that enumerates the neighbors of a cell
+ */
+template <typename Topology>
+class BasicBoard : public BoardState {
+public:
+    BasicBoard() = default;
+
+    /**
+     * @brief Generates a new random board
+     * @param width Width of the game grid
+     * @param height Height of the game grid
+     * @param bombCount Total number of bombs to place
+     * @param lives Number of lives for the game
+     * @param seed Seed for bomb placement, so a board can be regenerated
+     */
+    void generate(int width, int height, int bombCount, int lives, quint32 seed);
+
+    /**
+     * @brief Starts a new game with the same settings on a pre-generated layout
+     * The bomb planes are swapped with next, so next is left holding the old layout
+     * @param next A generated board with the same dimensions
+     */
+    void restart(BasicBoard& next);
+
+    /**
+     * @brief Reveals a cell, flood-filling through cells with no adjacent bombs
+     * @param index Index of the cell to reveal
+     * @return The cells that changed and the outcome of the move
+     */
+    BoardDiff reveal(int index);
+
+    /**
+     * @brief Reveals every open neighbor of a revealed number whose flags are all placed
+     * @param index Index of a revealed numbered cell
+     * @return The cells that changed and the outcome of the move, empty if the flag count does not match
+     */
+    BoardDiff chord(int index);
+
+    /**
+     * @brief Cycles the mark of an unrevealed cell (unmarked -> flag -> question mark)
+     */
+    BoardDiff toggleMark(int index);
+
+    /**
+     * @brief Reverts the most recent move still in the journal
+     */
+    BoardDiff undo();
+
+    /**
+     * @brief Reapplies the most recently undone move
+     */
+    BoardDiff redo();
+
+    /**
+     * @brief Calls visit(neighborIndex) for every neighbor of a cell
+     */
+    template <typename Visit>
+    void forEachNeighbor(int index, Visit&& visit) const {
+        Topology::forEachNeighbor(index, w, h, std::forward<Visit>(visit));
+    }
+
+    /**
+     * @brief Recalculates adjacency counts and the frontier after the planes were filled externally
+     */
+    void recalculate();
+
+    /**
+     * @brief The boundary between revealed and unrevealed cells
+     */
+    const Frontier<Topology>& frontier() const { return frontierSet; }
+
+    /**
+     * @brief Returns the frontier components changed since the previous call
+     */
+    QVector<FrontierComponent> takeChangedComponents() { return frontierSet.takeChangedComponents(*this); }
+
+private:
+    Frontier<Topology> frontierSet;   // Kept in step with every move
+
+    /**
+     * @brief Calculates the number of adjacent bombs for each cell
+     */
+    void calculateBombCounts();
+
+    /**
+     * @brief Reveals a set of cells as one move, flood-filling from each safe one
+     * @param seeds Unrevealed cells to reveal
+     * @return The cells that changed and the outcome of the move
+     */
+    BoardDiff revealCells(const QVector<int>& seeds);
+};
+
+// The board used by the GUI
+using Board = BasicBoard<SquareTopology>;
+
+// Sets up the board dimensions and places a fresh set of bombs
+template <typename Topology>
+void BasicBoard<Topology>::generate(int width, int height, int bombTotal, int lives, quint32 seed) {
+    bombCount = bombTotal;
+    livesMax = lives;
+    currentLives = lives;
+    boardSeed = seed;
+
+    allocate(width, height);
+    placeBombs();
+    calculateBombCounts();
+    frontierSet.reset(w * h);
+}
+
+template <typename Topology>
+void BasicBoard<Topology>::restart(BasicBoard& next) {
+    restartFrom(next);
+    frontierSet.reset(w * h);
+}
+
+template <typename Topology>
+void BasicBoard<Topology>::recalculate() {
+    calculateBombCounts();
+    frontierSet.rebuild(*this);
+}
+
+// Calculates the number of adjacent bombs for each cell
+template <typename Topology>
+void BasicBoard<Topology>::calculateBombCounts() {
+    const bool* bomb = bombs.constData();
+    quint8* counts = bombCounts.data();
+    for (int index = 0; index < w * h; ++index) {
+        int count = 0;
+        if (!bomb[index]) {
+            forEachNeighbor(index, [&](int neighborIndex) { count += bomb[neighborIndex]; });
+        }
+        counts[index] = quint8(count);
+    }
+}
+
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::reveal(int index) {
+    if (index < 0 || index >= w * h || revealed[index]) {
+        BoardDiff diff;
+        diff.lives = currentLives;
+        return diff;
+    }
+    return revealCells(QVector<int>{index});
+}
+
+// A chord only fires when the flags around the number account for all of its bombs
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::chord(int index) {
+    QVector<int> seeds;
+    if (index >= 0 && index < w * h && revealed[index] && !bombs[index] && bombCounts[index] > 0) {
+        int flags = 0;
+        forEachNeighbor(index, [&](int neighborIndex) {
+            if (!revealed[neighborIndex]) {
+                if (markState[neighborIndex] == 1) {
+                    ++flags;
+                } else {
+                    seeds.append(neighborIndex);
+                }
+            }
+        });
+        if (flags != bombCounts[index]) {
+            seeds.clear();
+        }
+    }
+    if (seeds.isEmpty()) {
+        BoardDiff diff;
+        diff.lives = currentLives;
+        return diff;
+    }
+    return revealCells(seeds);
+}
+
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::toggleMark(int index) {
+    BoardDiff diff = BoardState::toggleMark(index);
+    frontierSet.update(*this, diff);
+    return diff;
+}
+
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::undo() {
+    BoardDiff diff = BoardState::undo();
+    frontierSet.update(*this, diff);
+    return diff;
+}
+
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::redo() {
+    BoardDiff diff = BoardState::redo();
+    frontierSet.update(*this, diff);
+    return diff;
+}
+
+// Handles cell revelation
+// Implements flood-fill algorithm for empty cells
+// Manages life system and win conditions
+template <typename Topology>
+BoardDiff BasicBoard<Topology>::revealCells(const QVector<int>& seeds) {
+    BoardDiff diff;
+    JournalEntry entry;
+    entry.livesBefore = currentLives;
+
+    // Use a queue for BFS
+    QQueue<int> queue;
+    for (int index : seeds) {
+        if (!bombs[index]) {
+            queue.enqueue(index);
+            continue;
+        }
+
+        currentLives--;  // Decrease lives
+        if (markState[index] != 0) {
+            entry.clearedMarks << index << markState[index];
+        }
+        revealed[index] = true;
+        markState[index] = 0;
+        dirtyChunks[index / ChunkCells] = true;
+        diff.cells.append({index, CellMine});
+    }
+
+    while (!queue.isEmpty()) {
+        int curIndex = queue.dequeue();
+
+        // Skip already revealed cells
+        if (revealed[curIndex]) {
+            continue;
+        }
+
+        // Clear any flags or question marks for revealed cells
+        if (markState[curIndex] != 0) {
+            entry.clearedMarks << curIndex << markState[curIndex];
+        }
+        markState[curIndex] = 0;
+        revealed[curIndex] = true;
+        dirtyChunks[curIndex / ChunkCells] = true;
+        ++revealedSafe;
+        diff.cells.append({curIndex, bombCounts[curIndex]});
+
+        // Stop at cells that have adjacent bombs
+        if (bombCounts[curIndex] > 0) {
+            continue;
+        }
+
+        // Enqueue all valid neighbors
+        forEachNeighbor(curIndex, [&](int neighborIndex) {
+            if (!revealed[neighborIndex] && !bombs[neighborIndex]) {
+                queue.enqueue(neighborIndex);
+            }
+        });
+    }
+
+    // Running out of lives ends the game even if the same move cleared the board
+    diff.lives = currentLives;
+    if (currentLives < entry.livesBefore && currentLives <= 0) {
+        diff.outcome = MoveOutcome::OutOfLives;
+    } else if (revealedSafe == w * h - bombCount) {
+        diff.outcome = MoveOutcome::Won;
+    } else if (currentLives < entry.livesBefore) {
+        diff.outcome = MoveOutcome::HitMine;
+    }
+
+    journalReveal(entry, diff);
+    frontierSet.update(*this, diff);
+    return diff;
+}
+
+#endif //MINE_SWEEPER_BOARD_H
@@ -0,0 +1,180 @@
+#include "BoardFile.h"
+#include <QFile>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char Magic[4] = {'M', 'S', 'W', 'B'};
+const int PlaneCount = 4;   // bombs, revealed, flags, question marks
+
+static_assert(sizeof(BoardFileHeader) == 56, "BoardFileHeader layout must not change within a version");
+static_assert(BoardState::ChunkCells % 64 == 0, "Chunks must cover whole 64-bit words of a plane");
+const qint64 Version1HeaderBytes = 48;   // Version 1 headers stop before flags
+
+// Bytes before the planes in a file of the given version
+qint64 headerBytesFor(quint32 version) {
+    return version == 1 ? Version1HeaderBytes : qint64(sizeof(BoardFileHeader));
+}
+
+// Bytes per plane for the given number of cells, padded to whole 64-bit words
+qint64 planeBytesFor(qint64 cells) {
+    return ((cells + 63) / 64) * 8;
+}
+
+// Packs cells [begin, end) into the bit plane; begin must be a multiple of 8
+template <typename Test>
+void packRange(uchar* plane, int begin, int end, Test test) {
+    for (int index = begin; index < end; index += 8) {
+        uchar byte = 0;
+        int last = qMin(index + 8, end);
+        for (int cell = index; cell < last; ++cell) {
+            if (test(cell)) {
+                byte |= uchar(1u << (cell - index));
+            }
+        }
+        plane[index / 8] = byte;
+    }
+}
+
+// Reads one bit of a plane
+inline bool bitAt(const uchar* plane, int index) {
+    return (plane[index / 8] >> (index % 8)) & 1;
+}
+
+} // namespace
+
+// Writes the header and either every chunk or only the dirty ones
+bool BoardFile::save(BoardState& board, const QString& path) {
+    const int cells = board.cellCount();
+    const qint64 planeBytes = planeBytesFor(cells);
+    const qint64 fileSize = qint64(sizeof(BoardFileHeader)) + PlaneCount * planeBytes;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    bool incremental = file.size() == fileSize;
+    if (!incremental && !file.resize(fileSize)) {
+        return false;
+    }
+
+    uchar* data = file.map(0, fileSize);
+    if (!data) {
+        return false;
+    }
+
+    // Only trust the existing planes if they belong to this very game
+    BoardFileHeader* header = reinterpret_cast<BoardFileHeader*>(data);
+    incremental = incremental
+            && std::memcmp(header->magic, Magic, sizeof(Magic)) == 0
+            && header->version == Version
+            && header->width == quint32(board.w)
+            && header->height == quint32(board.h)
+            && header->bombCount == quint32(board.bombCount)
+            && header->seed == board.boardSeed
+            && header->chunkCells == quint32(BoardState::ChunkCells);
+
+    std::memcpy(header->magic, Magic, sizeof(Magic));
+    header->version = Version;
+    header->width = board.w;
+    header->height = board.h;
+    header->bombCount = board.bombCount;
+    header->maxLives = board.livesMax;
+    header->lives = board.currentLives;
+    header->seed = board.boardSeed;
+    header->revealedSafe = board.revealedSafe;
+    header->chunkCells = BoardState::ChunkCells;
+    header->planeBytes = planeBytes;
+    header->flags = board.undone ? UndoUsed : 0;
+    header->reserved = 0;
+
+    uchar* bombPlane = data + sizeof(BoardFileHeader);
+    uchar* revealedPlane = bombPlane + planeBytes;
+    uchar* flagPlane = revealedPlane + planeBytes;
+    uchar* questionPlane = flagPlane + planeBytes;
+
+    for (int chunk = 0; chunk < board.chunkCount(); ++chunk) {
+        if (incremental && !board.isChunkDirty(chunk)) {
+            continue;
+        }
+        int begin = chunk * BoardState::ChunkCells;
+        int end = qMin(begin + BoardState::ChunkCells, cells);
+        packRange(bombPlane, begin, end, [&](int i) { return board.bombs[i]; });
+        packRange(revealedPlane, begin, end, [&](int i) { return board.revealed[i]; });
+        packRange(flagPlane, begin, end, [&](int i) { return board.markState[i] == 1; });
+        packRange(questionPlane, begin, end, [&](int i) { return board.markState[i] == 2; });
+    }
+
+    file.unmap(data);
+    board.clearDirty();
+    return true;
+}
+
+// Validates the header and unpacks the planes straight out of the mapping
+// Adjacency counts are left to the caller, which knows the board's topology
+bool BoardFile::loadPlanes(BoardState& board, const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < Version1HeaderBytes) {
+        return false;
+    }
+
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    // Only the fields shared by every version are read before the version is known
+    const BoardFileHeader* header = reinterpret_cast<const BoardFileHeader*>(data);
+    const qint64 headerBytes = headerBytesFor(header->version);
+    const qint64 cells = qint64(header->width) * header->height;
+    const qint64 planeBytes = planeBytesFor(cells);
+    bool valid = std::memcmp(header->magic, Magic, sizeof(Magic)) == 0
+            && (header->version == 1 || header->version == Version)
+            && header->width > 0 && header->height > 0
+            && cells <= std::numeric_limits<int>::max()
+            && header->bombCount < cells
+            && header->maxLives >= 0
+            && header->lives <= header->maxLives
+            && header->lives >= (header->maxLives > 0 ? 0 : -1)
+            && header->planeBytes == quint64(planeBytes)
+            && file.size() == headerBytes + PlaneCount * planeBytes;
+    const uchar* bombPlane = data + headerBytes;
+    if (valid) {
+        // A bomb plane that disagrees with the header would make the win condition unreachable
+        qint64 bombs = 0;
+        for (qint64 index = 0; index < cells; ++index) {
+            bombs += bitAt(bombPlane, int(index));
+        }
+        valid = bombs == header->bombCount;
+    }
+    if (!valid) {
+        file.unmap(const_cast<uchar*>(data));
+        return false;
+    }
+
+    board.bombCount = header->bombCount;
+    board.livesMax = header->maxLives;
+    board.currentLives = header->lives;
+    board.boardSeed = header->seed;
+    board.allocate(header->width, header->height);
+    board.undone = header->version >= 2 && (header->flags & UndoUsed);
+
+    const uchar* revealedPlane = bombPlane + planeBytes;
+    const uchar* flagPlane = revealedPlane + planeBytes;
+    const uchar* questionPlane = flagPlane + planeBytes;
+
+    for (int index = 0; index < int(cells); ++index) {
+        board.bombs[index] = bitAt(bombPlane, index);
+        board.revealed[index] = bitAt(revealedPlane, index);
+        board.markState[index] = bitAt(flagPlane, index) ? 1 : bitAt(questionPlane, index) ? 2 : 0;
+        if (board.revealed[index] && !board.bombs[index]) {
+            ++board.revealedSafe;
+        }
+    }
+
+    file.unmap(const_cast<uchar*>(data));
+    // The board now matches the file, so the next save only writes new moves
+    board.clearDirty();
+    return true;
+}
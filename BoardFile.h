@@ -0,0 +1,66 @@
+#ifndef MINE_SWEEPER_BOARDFILE_H
+#define MINE_SWEEPER_BOARDFILE_H
+
+#include <QString>
+#include "Board.h"
+
+/**
+ * @brief Fixed-size header at the start of every save file
+ * The header is followed by four bit-packed planes of planeBytes bytes each:
+ * bombs, revealed cells, flags and question marks (bit i of a plane is cell i).
+ * Version 1 headers end after planeBytes; version 2 appends flags and padding.
+ */
+struct BoardFileHeader {
+    char magic[4];         // Always "MSWB"
+    quint32 version;       // BoardFile::Version
+    quint32 width;         // Width of the game grid
+    quint32 height;        // Height of the game grid
+    quint32 bombCount;     // Total number of bombs in the game
+    qint32 maxLives;       // Maximum lives for the game's difficulty
+    qint32 lives;          // Remaining lives
+    quint32 seed;          // Seed used to place the bombs
+    quint32 revealedSafe;  // Number of revealed non-bomb cells
+    quint32 chunkCells;    // Cells per dirty chunk when the file was written
+    quint64 planeBytes;    // Size of each plane, padded to a multiple of 8 bytes
+    quint32 flags;         // BoardFile::UndoUsed (version 2 and later)
+    quint32 reserved;      // Keeps the planes 8-byte aligned, always 0
+};
+
+/**
+ * @brief The BoardFile class saves and loads games in a versioned binary format
+ * Files are accessed through QFile::map, and saves only rewrite the chunks
+ * that changed since the previous save of the same game
+ */
+class BoardFile {
+public:
+    static const quint32 Version = 2;
+    static const quint32 UndoUsed = 1;   // Header flag: a move of the saved game was undone
+
+    /**
+     * @brief Writes the board to a file, updating only dirty chunks when the file already holds this game
+     * @param board The board to save; its dirty chunks are cleared on success
+     * @param path Path of the save file
+     * @return true if the board was written
+     */
+    static bool save(BoardState& board, const QString& path);
+
+    /**
+     * @brief Replaces the board with the game stored in a file
+     * @param board The board to load into
+     * @param path Path of the save file
+     * @return true if the file was a valid save and the board was loaded
+     */
+    template <typename Topology>
+    static bool load(BasicBoard<Topology>& board, const QString& path) {
+        if (!loadPlanes(board, path)) {
+            return false;
+        }
+        board.recalculate();
+        return true;
+    }
+
+private:
+    static bool loadPlanes(BoardState& board, const QString& path);
+};
+
+#endif //MINE_SWEEPER_BOARDFILE_H
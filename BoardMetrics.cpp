@@ -0,0 +1,129 @@
+#include "BoardMetrics.h"
+#include <utility>
+
+namespace {
+
+// Union-find over provisional opening labels, with path halving and union by size
+struct OpeningLabels {
+    QVector<int> parent;
+    QVector<quint32> size;   // Empty cells under each root
+
+    int create() {
+        parent.append(parent.size());
+        size.append(0);
+        return parent.size() - 1;
+    }
+
+    int find(int label) {
+        while (parent[label] != label) {
+            parent[label] = parent[parent[label]];
+            label = parent[label];
+        }
+        return label;
+    }
+
+    int unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) {
+            if (size[a] < size[b]) {
+                std::swap(a, b);
+            }
+            parent[b] = a;
+            size[a] += size[b];
+        }
+        return a;
+    }
+};
+
+} // namespace
+
+// Cells are visited in memory order. An empty cell joins the labels of its already visited
+// neighbors (west, north-west, north, north-east). Whether a number borders an empty cell is read
+// from a per-row mask of columns whose 3-cell vertical strip holds an empty cell.
+BoardMetrics BoardMetrics::measure(const Board& board) {
+    BoardMetrics metrics;
+    int width = board.width();
+    int height = board.height();
+
+    // Empty-cell flags for the previous, current and next row
+    QVector<quint8> emptyAbove(width, 0);
+    QVector<quint8> emptyHere(width, 0);
+    QVector<quint8> emptyBelow(width, 0);
+    QVector<quint8> strip(width + 2, 0);   // strip[col + 1]: an empty cell in rows row-1..row+1 of col
+    auto fillEmpty = [&](int row, QVector<quint8>& flags) {
+        for (int col = 0; col < width; ++col) {
+            int index = row * width + col;
+            flags[col] = !board.isBomb(index) && board.adjacentBombs(index) == 0;
+        }
+    };
+    if (height > 0) {
+        fillEmpty(0, emptyBelow);
+    }
+
+    OpeningLabels labels;
+    QVector<int> above(width, -1);     // Opening label of each empty cell in the previous row
+    QVector<int> current(width, -1);   // Same for the row being scanned
+    for (int row = 0; row < height; ++row) {
+        std::swap(emptyAbove, emptyHere);
+        std::swap(emptyHere, emptyBelow);
+        if (row + 1 < height) {
+            fillEmpty(row + 1, emptyBelow);
+        } else {
+            emptyBelow.fill(0);
+        }
+        if (row == 0) {
+            emptyAbove.fill(0);
+        }
+        for (int col = 0; col < width; ++col) {
+            strip[col + 1] = emptyAbove[col] | emptyHere[col] | emptyBelow[col];
+        }
+
+        for (int col = 0; col < width; ++col) {
+            int index = row * width + col;
+            current[col] = -1;
+            if (board.isBomb(index)) {
+                continue;
+            }
+
+            if (!emptyHere[col]) {
+                metrics.isolatedNumbers += !(strip[col] | strip[col + 1] | strip[col + 2]);
+                continue;
+            }
+
+            int label = -1;
+            int neighbors[4] = {col > 0 ? current[col - 1] : -1, col > 0 ? above[col - 1] : -1,
+                                above[col], col + 1 < width ? above[col + 1] : -1};
+            for (int neighbor : neighbors) {
+                if (neighbor >= 0) {
+                    label = label < 0 ? labels.find(neighbor) : labels.unite(label, neighbor);
+                }
+            }
+            if (label < 0) {
+                label = labels.create();
+            }
+            ++labels.size[label];
+            current[col] = label;
+        }
+        std::swap(above, current);
+    }
+
+    for (int label = 0; label < labels.parent.size(); ++label) {
+        if (labels.parent[label] != label) {
+            continue;
+        }
+        quint32 size = labels.size[label];
+        int bucket = 0;
+        while ((size >> (bucket + 1)) != 0) {
+            ++bucket;
+        }
+        if (metrics.openingSizes.size() <= bucket) {
+            metrics.openingSizes.resize(bucket + 1);
+        }
+        ++metrics.openingSizes[bucket];
+        ++metrics.openings;
+        metrics.largestOpening = qMax(metrics.largestOpening, size);
+    }
+    metrics.bbbv = metrics.openings + metrics.isolatedNumbers;
+    return metrics;
+}
@@ -0,0 +1,47 @@
+#ifndef MINE_SWEEPER_BOARDMETRICS_H
+#define MINE_SWEEPER_BOARDMETRICS_H
+
+#include <QVector>
+#include "Board.h"
+#include "Solver.h"
+
+/**
+ * @brief Difficulty metrics of a bomb layout
+ *
+ * An opening is a connected region of empty cells (no adjacent bombs); one click
+ * on it reveals the whole region and its border. An isolated number borders no
+ * opening and needs a click of its own, so the 3BV (the minimum number of clicks
+ * that clears the board) is openings + isolatedNumbers.
+ */
+struct BoardMetrics {
+    quint32 bbbv = 0;              // Minimum clicks to clear the board
+    quint32 openings = 0;          // Connected regions of empty cells
+    quint32 isolatedNumbers = 0;   // Numbered cells that border no opening
+    quint32 largestOpening = 0;    // Empty cells in the largest opening
+    QVector<quint32> openingSizes; // Openings with [2^k, 2^(k+1)) empty cells, indexed by k
+
+    /**
+     * @brief Computes every metric in one row-by-row pass over the bomb planes
+     * Openings are labeled with a union-find over the current and previous row only,
+     * so memory beyond the board grows with the width and the number of openings.
+     * The labeling assumes 8-cell square neighborhoods, so only square boards are accepted.
+     */
+    static BoardMetrics measure(const Board& board);
+
+    /**
+     * @brief Counts the guesses the solver needs to clear the board, including the first click
+     * The board is replayed from the start with a life for every cell, so wrong guesses do not end it
+     * @param board The layout to play; its own game state is left untouched
+     * @param guessSeed Seed for choosing guesses; it must differ from the board's seed
+     */
+    template <typename Topology>
+    static int guessCount(const BasicBoard<Topology>& board, quint32 guessSeed) {
+        BasicBoard<Topology> layout = board;
+        BasicBoard<Topology> trial;
+        trial.generate(board.width(), board.height(), 0, board.cellCount(), guessSeed);
+        trial.restart(layout);   // Takes the bomb planes and starts a fresh game on them
+        return Solver<Topology>().playOut(trial, guessSeed);
+    }
+};
+
+#endif //MINE_SWEEPER_BOARDMETRICS_H
@@ -0,0 +1,202 @@
+#include "BoardState.h"
+#include <QRandomGenerator>
+
+// Sizes every plane for the given dimensions and clears the player state
+void BoardState::allocate(int width, int height) {
+    w = width;
+    h = height;
+    revealedSafe = 0;
+    undone = false;
+
+    bombs.resize(w * h);
+    bombCounts.resize(w * h);
+    revealed.resize(w * h);
+    markState.resize(w * h);
+    revealed.fill(false);
+    markState.fill(0);
+    journal.clear();
+
+    // A fresh board has never been saved
+    dirtyChunks.resize(int((qint64(w) * h + ChunkCells - 1) / ChunkCells));
+    dirtyChunks.fill(true);
+}
+
+// Takes over the bomb planes of a pre-generated board and clears the player state in bulk
+void BoardState::restartFrom(BoardState& next) {
+    Q_ASSERT(next.w == w && next.h == h);
+    bombs.swap(next.bombs);
+    bombCounts.swap(next.bombCounts);
+    bombCount = next.bombCount;
+    boardSeed = next.boardSeed;
+    currentLives = livesMax;
+    revealedSafe = 0;
+    undone = false;
+
+    revealed.fill(false);
+    markState.fill(0);
+    dirtyChunks.fill(true);
+    journal.clear();
+}
+
+// Randomly places bombs on the grid
+void BoardState::placeBombs() {
+    bombs.fill(false);
+    QRandomGenerator generator(boardSeed);
+    int placedBombs = 0;
+    while (placedBombs < bombCount) {
+        int index = generator.bounded(w * h);
+        if (!bombs[index]) {
+            bombs[index] = true;
+            ++placedBombs;
+        }
+    }
+}
+
+// Journals a reveal as runs of cell indices
+void BoardState::journalReveal(JournalEntry& entry, const BoardDiff& diff) {
+    QVector<int> indices;
+    indices.reserve(diff.cells.size());
+    for (const CellChange& change : diff.cells) {
+        indices.append(change.index);
+    }
+    entry.livesAfter = currentLives;
+    entry.spans = Journal::toSpans(std::move(indices));
+    journal.record(std::move(entry));
+}
+
+// Handles cell marking (flag -> question mark -> unmarked)
+BoardDiff BoardState::toggleMark(int index) {
+    BoardDiff diff;
+    diff.lives = currentLives;
+
+    // Skip if already revealed
+    if (index < 0 || index >= w * h || revealed[index]) {
+        return diff;
+    }
+
+    JournalEntry entry;
+    entry.livesBefore = currentLives;
+    entry.livesAfter = currentLives;
+    entry.markIndex = index;
+    entry.markBefore = markState[index];
+    journal.record(std::move(entry));
+
+    // Cycle through states: 0 -> 1 -> 2 -> 0
+    markState[index] = (markState[index] + 1) % 3;
+    dirtyChunks[index / ChunkCells] = true;
+    diff.cells.append({index, cellView(index)});
+    return diff;
+}
+
+// Puts the board back to how it was before the last journaled move
+BoardDiff BoardState::undo() {
+    BoardDiff diff;
+    const JournalEntry* entry = journal.undo();
+    if (entry) {
+        if (entry->markIndex >= 0) {
+            markState[entry->markIndex] = entry->markBefore;
+            dirtyChunks[entry->markIndex / ChunkCells] = true;
+            diff.cells.append({entry->markIndex, cellView(entry->markIndex)});
+        } else {
+            applySpans(*entry, false, diff);
+        }
+        currentLives = entry->livesBefore;
+        undone = true;
+    }
+    diff.lives = currentLives;
+    return diff;
+}
+
+// Applies the last undone move again, reporting the same outcome it had originally
+BoardDiff BoardState::redo() {
+    BoardDiff diff;
+    const JournalEntry* entry = journal.redo();
+    if (entry) {
+        if (entry->markIndex >= 0) {
+            markState[entry->markIndex] = (entry->markBefore + 1) % 3;
+            dirtyChunks[entry->markIndex / ChunkCells] = true;
+            diff.cells.append({entry->markIndex, cellView(entry->markIndex)});
+        } else {
+            applySpans(*entry, true, diff);
+        }
+        currentLives = entry->livesAfter;
+
+        if (currentLives < entry->livesBefore && currentLives <= 0) {
+            diff.outcome = MoveOutcome::OutOfLives;
+        } else if (revealedSafe == w * h - bombCount) {
+            diff.outcome = MoveOutcome::Won;
+        } else if (currentLives < entry->livesBefore) {
+            diff.outcome = MoveOutcome::HitMine;
+        }
+    }
+    diff.lives = currentLives;
+    return diff;
+}
+
+// Walks the runs of a reveal entry, touching only the cells it changed
+void BoardState::applySpans(const JournalEntry& entry, bool show, BoardDiff& diff) {
+    for (int i = 0; i < entry.spans.size(); i += 2) {
+        int end = entry.spans[i] + entry.spans[i + 1];
+        for (int index = entry.spans[i]; index < end; ++index) {
+            revealed[index] = show;
+            markState[index] = 0;
+            if (!bombs[index]) {
+                revealedSafe += show ? 1 : -1;
+            }
+            dirtyChunks[index / ChunkCells] = true;
+        }
+    }
+
+    // Hiding a cell brings back the mark it had before it was revealed
+    if (!show) {
+        for (int i = 0; i < entry.clearedMarks.size(); i += 2) {
+            markState[entry.clearedMarks[i]] = quint8(entry.clearedMarks[i + 1]);
+        }
+    }
+
+    for (int i = 0; i < entry.spans.size(); i += 2) {
+        int end = entry.spans[i] + entry.spans[i + 1];
+        for (int index = entry.spans[i]; index < end; ++index) {
+            diff.cells.append({index, cellView(index)});
+        }
+    }
+}
+
+// Copies the visible state of every cell
+BoardSnapshot BoardState::snapshot() const {
+    BoardSnapshot snap;
+    snap.width = w;
+    snap.height = h;
+    snap.bombCount = bombCount;
+    snap.maxLives = livesMax;
+    snap.lives = currentLives;
+    snap.cells.resize(w * h);
+    for (int index = 0; index < w * h; ++index) {
+        snap.cells[index] = cellView(index);
+    }
+    return snap;
+}
+
+// Maps the internal cell state to what the player sees
+quint8 BoardState::cellView(int index) const {
+    if (revealed[index]) {
+        return bombs[index] ? quint8(CellMine) : bombCounts[index];
+    }
+    switch (markState[index]) {
+        case 1: return CellFlagged;
+        case 2: return CellQuestioned;
+        default: return CellHidden;
+    }
+}
+
+// A game ends on a win, or when a mine is hit with no lives to spare
+bool BoardState::isOver() const {
+    if (revealedSafe == w * h - bombCount) {
+        return true;
+    }
+    return livesMax > 0 ? currentLives <= 0 : currentLives < 0;
+}
+
+bool BoardState::isWon() const {
+    return revealedSafe == w * h - bombCount && (livesMax > 0 ? currentLives > 0 : currentLives >= 0);
+}
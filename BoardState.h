@@ -0,0 +1,194 @@
+#ifndef MINE_SWEEPER_BOARDSTATE_H
+#define MINE_SWEEPER_BOARDSTATE_H
+
+#include <QVector>
+#include <QMetaType>
+#include "Journal.h"
+
+/**
+ * @brief What the player can see of a single cell
+ * Values 0-8 are revealed cells showing their adjacent bomb count
+ */
+enum CellView : quint8 {
+    CellHidden = 9,      // Unrevealed, unmarked cell
+    CellFlagged = 10,    // Unrevealed cell marked with a flag
+    CellQuestioned = 11, // Unrevealed cell marked with a question mark
+    CellMine = 12        // Revealed bomb
+};
+
+/**
+ * @brief Result of a single player move
+ */
+enum class MoveOutcome {
+    None,       // Game continues
+    HitMine,    // A bomb was revealed but lives remain
+    OutOfLives, // A bomb was revealed and no lives remain
+    Won         // All non-bomb cells are revealed
+};
+
+/**
+ * @brief A single cell whose view changed during a move
+ */
+struct CellChange {
+    int index;   // Cell index (row * width + col)
+    quint8 view; // New CellView value
+};
+
+/**
+ * @brief The cells changed by one move, sent from the engine to the view
+ */
+struct BoardDiff {
+    QVector<CellChange> cells;            // Changed cells in reveal order
+    int lives = 0;                        // Remaining lives after the move
+    MoveOutcome outcome = MoveOutcome::None;
+};
+
+/**
+ * @brief Immutable copy of everything the view needs to draw a board
+ */
+struct BoardSnapshot {
+    int width = 0;          // Width of the game grid
+    int height = 0;         // Height of the game grid
+    int bombCount = 0;      // Total number of bombs in the game
+    int maxLives = 0;       // Maximum lives for this game
+    int lives = 0;          // Remaining lives
+    QVector<quint8> cells;  // CellView value for every cell
+};
+
+/**
+ * @brief The BoardState class holds the planes and rules that do not depend on the board's topology
+ * It never touches the GUI, so it can be owned by a worker thread
+ */
+class BoardState {
+    friend class BoardFile;
+    friend class BoardStream;
+
+public:
+    static const int ChunkCells = 4096;   // Cells per dirty-tracking chunk (a multiple of 8)
+
+    /**
+     * @brief Cycles the mark of an unrevealed cell (unmarked -> flag -> question mark)
+     * @param index Index of the cell to mark
+     * @return The cells that changed
+     */
+    BoardDiff toggleMark(int index);
+
+    /**
+     * @brief Reverts the most recent move still in the journal
+     * @return The cells that changed, or an empty diff if there is nothing to undo
+     */
+    BoardDiff undo();
+
+    /**
+     * @brief Reapplies the most recently undone move
+     * @return The cells that changed and the outcome of the move
+     */
+    BoardDiff redo();
+
+    /**
+     * @brief Copies the visible state of the whole board
+     */
+    BoardSnapshot snapshot() const;
+
+    /**
+     * @brief Returns what the player sees at a cell
+     */
+    quint8 cellView(int index) const;
+
+    int width() const { return w; }
+    int height() const { return h; }
+    int cellCount() const { return w * h; }
+    int bombTotal() const { return bombCount; }
+    int maxLives() const { return livesMax; }
+    int lives() const { return currentLives; }
+    quint32 seed() const { return boardSeed; }
+    bool isRevealed(int index) const { return revealed[index]; }
+    bool isBomb(int index) const { return bombs[index]; }
+    quint8 mark(int index) const { return markState[index]; }
+    int adjacentBombs(int index) const { return bombCounts[index]; }
+
+    /**
+     * @brief Returns true once the game is won or out of lives
+     */
+    bool isOver() const;
+
+    /**
+     * @brief Returns true if every safe cell is revealed and lives remain
+     * A move that clears the board but runs out of lives is a loss
+     */
+    bool isWon() const;
+
+    /**
+     * @brief Returns true if a move of the current game was ever undone
+     * Such games may have taken back mine hits, so they are kept out of the statistics
+     */
+    bool undoUsed() const { return undone; }
+
+    /**
+     * @brief Number of dirty-tracking chunks covering the board
+     */
+    int chunkCount() const { return dirtyChunks.size(); }
+
+    /**
+     * @brief Returns true if a chunk changed since the last clearDirty()
+     */
+    bool isChunkDirty(int chunk) const { return dirtyChunks[chunk]; }
+
+    /**
+     * @brief Marks every chunk as saved
+     */
+    void clearDirty() { dirtyChunks.fill(false); }
+
+protected:
+    int w = 0;               // Width of the game grid
+    int h = 0;               // Height of the game grid
+    int bombCount = 0;       // Total number of bombs in the game
+    int livesMax = 0;        // Maximum lives for current difficulty
+    int currentLives = 0;    // Current remaining lives
+    int revealedSafe = 0;    // Number of revealed non-bomb cells
+    quint32 boardSeed = 0;   // Seed used to place the bombs
+    bool undone = false;     // A move of this game was undone
+    QVector<bool> bombs;             // Bomb locations
+    QVector<quint8> bombCounts;      // Number of adjacent bombs for each cell
+    QVector<bool> revealed;          // Revealed cells
+    QVector<quint8> markState;       // 0: unmarked, 1: flagged, 2: question mark
+    QVector<bool> dirtyChunks;       // Chunks changed since the last save
+    Journal journal;                 // Undo/redo history of the current game
+
+    BoardState() = default;
+
+    /**
+     * @brief Sizes and clears every plane for a board of the given dimensions
+     */
+    void allocate(int width, int height);
+
+    /**
+     * @brief Takes over the bomb planes of another board and clears the player state
+     */
+    void restartFrom(BoardState& next);
+
+    /**
+     * @brief Places bombs randomly on the grid using the board seed
+     */
+    void placeBombs();
+
+    /**
+     * @brief Records a finished reveal in the journal
+     * @param entry Journal entry holding the lives and cleared marks of the move
+     * @param diff The cells the reveal uncovered
+     */
+    void journalReveal(JournalEntry& entry, const BoardDiff& diff);
+
+    /**
+     * @brief Reveals or hides every cell in the spans of a journal entry
+     * @param entry The move being undone or redone
+     * @param show true to reveal the cells, false to hide them again
+     * @param diff Receives the new view of every affected cell
+     */
+    void applySpans(const JournalEntry& entry, bool show, BoardDiff& diff);
+};
+
+Q_DECLARE_METATYPE(BoardDiff)
+Q_DECLARE_METATYPE(BoardSnapshot)
+
+#endif //MINE_SWEEPER_BOARDSTATE_H
@@ -0,0 +1,321 @@
+#include "BoardStream.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const int BufferSize = 64 * 1024;   // Fixed I/O buffer, independent of board size
+
+// Collects output in a fixed buffer and hands it to the device in large writes
+class StreamWriter {
+public:
+    explicit StreamWriter(QIODevice& device) : device(device) {}
+
+    void put(char c) {
+        if (used == BufferSize) {
+            flush();
+        }
+        buffer[used++] = c;
+    }
+
+    void put(const char* text) {
+        while (*text) {
+            put(*text++);
+        }
+    }
+
+    void putNumber(qint64 value) {
+        char digits[24];
+        std::snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(value));
+        put(digits);
+    }
+
+    bool flush() {
+        if (used > 0 && device.write(buffer, used) != used) {
+            ok = false;
+        }
+        used = 0;
+        return ok;
+    }
+
+private:
+    QIODevice& device;
+    char buffer[BufferSize];
+    int used = 0;
+    bool ok = true;
+};
+
+// Hands out input one character at a time from a fixed buffer
+class StreamReader {
+public:
+    explicit StreamReader(QIODevice& device) : device(device) {}
+
+    // Returns the next character without consuming it, or -1 at the end of input
+    int peek() {
+        if (pos == size) {
+            qint64 read = device.read(buffer, BufferSize);
+            size = read > 0 ? int(read) : 0;
+            pos = 0;
+        }
+        return pos < size ? static_cast<unsigned char>(buffer[pos]) : -1;
+    }
+
+    int get() {
+        int c = peek();
+        if (c >= 0) {
+            ++pos;
+        }
+        return c;
+    }
+
+    // Skips spaces, tabs and, optionally, line breaks
+    void skipSpace(bool lineBreaks) {
+        for (int c = peek(); c == ' ' || c == '\t' || (lineBreaks && (c == '\r' || c == '\n')); c = peek()) {
+            get();
+        }
+    }
+
+    // Consumes the rest of the current line including its line break
+    void skipLine() {
+        for (int c = get(); c >= 0 && c != '\n'; c = get()) {
+        }
+    }
+
+    // Reads a non-negative decimal number
+    bool readNumber(qint64& value) {
+        if (peek() < '0' || peek() > '9') {
+            return false;
+        }
+        value = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            value = value * 10 + (get() - '0');
+            if (value > std::numeric_limits<int>::max()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool expect(char c) {
+        return get() == c;
+    }
+
+private:
+    QIODevice& device;
+    char buffer[BufferSize];
+    int size = 0;
+    int pos = 0;
+};
+
+} // namespace
+
+// Cell indices are ints, so the planes of a larger board could not be addressed
+bool BoardStream::validDimensions(qint64 width, qint64 height) {
+    return width > 0 && height > 0 && width * height <= std::numeric_limits<int>::max();
+}
+
+BoardStream::Format BoardStream::formatForPath(const QString& path) {
+    return path.endsWith(".json", Qt::CaseInsensitive) ? Format::Json : Format::Text;
+}
+
+// Streams the bomb plane out one row at a time
+bool BoardStream::write(const BoardState& board, QIODevice& device, Format format) {
+    StreamWriter out(device);
+    const int width = board.w;
+    const int height = board.h;
+
+    if (format == Format::Json) {
+        out.put("{\"width\": ");
+        out.putNumber(width);
+        out.put(", \"height\": ");
+        out.putNumber(height);
+        out.put(", \"mines\": ");
+        out.putNumber(board.bombCount);
+        out.put(", \"rows\": [\n");
+    } else {
+        out.putNumber(width);
+        out.put(' ');
+        out.putNumber(height);
+        out.put('\n');
+    }
+
+    for (int row = 0; row < height; ++row) {
+        const bool* bombRow = board.bombs.constData() + qint64(row) * width;
+        if (format == Format::Json) {
+            out.put("  \"");
+        }
+        for (int col = 0; col < width; ++col) {
+            out.put(bombRow[col] ? '*' : '.');
+        }
+        if (format == Format::Json) {
+            out.put(row + 1 < height ? "\",\n" : "\"\n");
+        } else {
+            out.put('\n');
+        }
+    }
+
+    if (format == Format::Json) {
+        out.put("]}\n");
+    }
+    return out.flush();
+}
+
+// Fills the bomb plane from the stream and sets up the game around it
+bool BoardStream::readPlanes(BoardState& board, QIODevice& device, Format format, int lives) {
+    qint64 declaredMines = -1;
+    bool ok = format == Format::Json ? readJson(board, device, declaredMines) : readText(board, device);
+    if (!ok) {
+        return false;
+    }
+
+    int bombs = 0;
+    for (int index = 0; index < board.cellCount(); ++index) {
+        if (board.bombs[index]) {
+            ++bombs;
+        }
+    }
+    // A layout without a safe cell would count as won before the first click
+    if (bombs >= board.cellCount()) {
+        return false;
+    }
+    // A JSON "mines" field, when present, must agree with the layout
+    if (declaredMines >= 0 && declaredMines != bombs) {
+        return false;
+    }
+    board.bombCount = bombs;
+    board.livesMax = lives;
+    board.currentLives = lives;
+    board.boardSeed = 0;   // Imported layouts were not generated from a seed
+    return true;
+}
+
+bool BoardStream::readText(BoardState& board, QIODevice& device) {
+    StreamReader in(device);
+
+    // Skip leading comments and blank lines
+    for (in.skipSpace(true); in.peek() == '#'; in.skipSpace(true)) {
+        in.skipLine();
+    }
+
+    qint64 width = 0;
+    qint64 height = 0;
+    if (!in.readNumber(width)) {
+        return false;
+    }
+    in.skipSpace(false);
+    if (!in.readNumber(height) || !validDimensions(width, height)) {
+        return false;
+    }
+    in.skipLine();
+
+    board.allocate(int(width), int(height));
+    for (int row = 0; row < height; ++row) {
+        bool* bombRow = board.bombs.data() + qint64(row) * width;
+        for (int col = 0; col < width; ++col) {
+            int c = in.get();
+            if (c != '*' && c != '.') {
+                return false;
+            }
+            bombRow[col] = c == '*';
+        }
+        if (in.peek() == '\r') {
+            in.get();
+        }
+        // Every row ends with a line break, except that the last one may end the input
+        int end = in.get();
+        if (end != '\n' && !(end < 0 && row + 1 == height)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoardStream::readJson(BoardState& board, QIODevice& device, qint64& mines) {
+    StreamReader in(device);
+    qint64 width = 0;
+    qint64 height = 0;
+    bool haveRows = false;
+
+    in.skipSpace(true);
+    if (!in.expect('{')) {
+        return false;
+    }
+
+    for (;;) {
+        // Keys are short and known, so a tiny fixed buffer is enough
+        char key[16];
+        int length = 0;
+        in.skipSpace(true);
+        if (!in.expect('"')) {
+            return false;
+        }
+        for (int c = in.get(); c != '"'; c = in.get()) {
+            if (c < 0 || length + 1 == int(sizeof(key))) {
+                return false;
+            }
+            key[length++] = char(c);
+        }
+        key[length] = '\0';
+
+        in.skipSpace(true);
+        if (!in.expect(':')) {
+            return false;
+        }
+        in.skipSpace(true);
+
+        if (std::strcmp(key, "width") == 0) {
+            if (!in.readNumber(width)) return false;
+        } else if (std::strcmp(key, "height") == 0) {
+            if (!in.readNumber(height)) return false;
+        } else if (std::strcmp(key, "mines") == 0) {
+            if (!in.readNumber(mines)) return false;
+        } else if (std::strcmp(key, "rows") == 0) {
+            if (haveRows || !validDimensions(width, height) || !in.expect('[')) {
+                return false;
+            }
+            board.allocate(int(width), int(height));
+            for (int row = 0; row < height; ++row) {
+                bool* bombRow = board.bombs.data() + qint64(row) * width;
+                in.skipSpace(true);
+                if (row > 0) {
+                    if (!in.expect(',')) {
+                        return false;
+                    }
+                    in.skipSpace(true);
+                }
+                if (!in.expect('"')) {
+                    return false;
+                }
+                for (int col = 0; col < width; ++col) {
+                    int c = in.get();
+                    if (c != '*' && c != '.') {
+                        return false;
+                    }
+                    bombRow[col] = c == '*';
+                }
+                if (!in.expect('"')) {
+                    return false;
+                }
+            }
+            in.skipSpace(true);
+            if (!in.expect(']')) {
+                return false;
+            }
+            haveRows = true;
+        } else {
+            return false;
+        }
+
+        in.skipSpace(true);
+        int c = in.get();
+        if (c == '}') {
+            break;
+        }
+        if (c != ',') {
+            return false;
+        }
+    }
+
+    return haveRows;
+}
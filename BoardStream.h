@@ -0,0 +1,71 @@
+#ifndef MINE_SWEEPER_BOARDSTREAM_H
+#define MINE_SWEEPER_BOARDSTREAM_H
+
+#include <QIODevice>
+#include <QString>
+#include "Board.h"
+
+/**
+ * @brief The BoardStream class imports and exports bomb layouts for external tools
+ *
+ * Text format: an optional run of '#' comment lines, a "width height" line,
+ * then one line per row using '*' for a bomb and '.' for a safe cell.
+ *
+ * JSON format: {"width": W, "height": H, "mines": N, "rows": ["..*.", ...]}
+ * with "width" and "height" appearing before "rows".
+ *
+ * Both directions stream row by row through a fixed-size buffer and read or
+ * write the board planes directly, so no per-cell objects are ever created.
+ */
+class BoardStream {
+public:
+    enum class Format {
+        Text,
+        Json
+    };
+
+    /**
+     * @brief Picks the format from a file name (".json" is JSON, anything else is text)
+     */
+    static Format formatForPath(const QString& path);
+
+    /**
+     * @brief Returns true if a board of the given size can be read, written or generated
+     * Streams declaring any other size are rejected before the board planes are sized
+     */
+    static bool validDimensions(qint64 width, qint64 height);
+
+    /**
+     * @brief Writes the bomb layout of a board
+     * @param board The board to export
+     * @param device Open, writable device
+     * @param format Output format
+     * @return true if every byte was written
+     */
+    static bool write(const BoardState& board, QIODevice& device, Format format);
+
+    /**
+     * @brief Replaces the board with a bomb layout read from a device
+     * @param board The board to import into; nothing is revealed afterwards, and it is left
+     *              partially filled if the input is malformed
+     * @param device Open, readable device
+     * @param format Input format
+     * @param lives Number of lives for the imported game
+     * @return true if the input was a well-formed board
+     */
+    template <typename Topology>
+    static bool read(BasicBoard<Topology>& board, QIODevice& device, Format format, int lives) {
+        if (!readPlanes(board, device, format, lives)) {
+            return false;
+        }
+        board.recalculate();
+        return true;
+    }
+
+private:
+    static bool readPlanes(BoardState& board, QIODevice& device, Format format, int lives);
+    static bool readText(BoardState& board, QIODevice& device);
+    static bool readJson(BoardState& board, QIODevice& device, qint64& mines);
+};
+
+#endif //MINE_SWEEPER_BOARDSTREAM_H
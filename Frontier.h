@@ -0,0 +1,259 @@
+#ifndef MINE_SWEEPER_FRONTIER_H
+#define MINE_SWEEPER_FRONTIER_H
+
+#include <QVector>
+#include <QSet>
+#include "BoardState.h"
+
+/**
+ * @brief One connected piece of the frontier
+ * Unknowns are linked through the numbers they share, so each component can be
+ * solved or scored independently of the rest of the board
+ */
+struct FrontierComponent {
+    QVector<int> numbers;    // Revealed numbered cells in the component
+    QVector<int> unknowns;   // Unrevealed, unflagged cells in the component
+};
+
+/**
+ * @brief The Frontier class tracks the boundary between revealed and unrevealed cells
+ *
+ * Numbers are revealed cells with a nonzero bomb count and at least one open
+ * neighbor (unrevealed and not flagged). Unknowns are open cells next to at
+ * least one such number. Both are kept as indexed sets and updated from each
+ * move's diff, touching only the changed cells and their neighborhoods.
+ *
+ * @tparam Topology Policy from Topology.h that enumerates the neighbors of a cell
+ */
+template <typename Topology>
+class Frontier {
+public:
+    /**
+     * @brief Empties the frontier for a board with the given number of cells
+     */
+    void reset(int cellCount);
+
+    /**
+     * @brief Recomputes the frontier from scratch, e.g. after loading a board
+     */
+    void rebuild(const BoardState& board);
+
+    /**
+     * @brief Updates the frontier for the cells changed by one move
+     * @param board The board after the move
+     * @param diff The cells the move changed
+     */
+    void update(const BoardState& board, const BoardDiff& diff);
+
+    const QVector<int>& numbers() const { return numberList; }
+    const QVector<int>& unknowns() const { return unknownList; }
+    bool isNumber(int index) const { return slot[index] >= 0 && isNumberSlot[index]; }
+    bool isUnknown(int index) const { return slot[index] >= 0 && !isNumberSlot[index]; }
+
+    /**
+     * @brief Returns every connected component of the frontier
+     */
+    QVector<FrontierComponent> components(const BoardState& board) const;
+
+    /**
+     * @brief Returns the components touched since the previous call, then forgets the touched cells
+     */
+    QVector<FrontierComponent> takeChangedComponents(const BoardState& board);
+
+private:
+    QVector<int> numberList;        // Frontier numbers, in no particular order
+    QVector<int> unknownList;       // Frontier unknowns, in no particular order
+    QVector<int> slot;              // Position of each cell in its list, -1 if not on the frontier
+    QVector<bool> isNumberSlot;     // Which list slot refers to
+    QVector<quint8> adjacentNumbers;   // Frontier numbers next to each cell
+    QVector<int> touched;           // Cells whose membership changed since the last query, each listed once
+    QVector<bool> isTouched;        // Which cells are in touched
+
+    static bool isOpen(const BoardState& board, int index) {
+        return !board.isRevealed(index) && board.mark(index) != 1;
+    }
+
+    void touch(int index);
+    bool shouldBeNumber(const BoardState& board, int index) const;
+    void refreshNumber(const BoardState& board, int index);
+    void refreshUnknown(const BoardState& board, int index);
+    void insert(QVector<int>& list, bool number, int index);
+    void remove(QVector<int>& list, int index);
+    FrontierComponent collect(const BoardState& board, int start, QSet<int>& visited) const;
+};
+
+template <typename Topology>
+void Frontier<Topology>::reset(int cellCount) {
+    numberList.clear();
+    unknownList.clear();
+    touched.clear();
+    slot.resize(cellCount);
+    slot.fill(-1);
+    isNumberSlot.resize(cellCount);
+    isNumberSlot.fill(false);
+    adjacentNumbers.resize(cellCount);
+    adjacentNumbers.fill(0);
+    isTouched.resize(cellCount);
+    isTouched.fill(false);
+}
+
+template <typename Topology>
+void Frontier<Topology>::rebuild(const BoardState& board) {
+    reset(board.cellCount());
+    for (int index = 0; index < board.cellCount(); ++index) {
+        refreshNumber(board, index);
+    }
+}
+
+// A changed cell can only affect its own membership and that of its neighbors
+template <typename Topology>
+void Frontier<Topology>::update(const BoardState& board, const BoardDiff& diff) {
+    for (const CellChange& change : diff.cells) {
+        refreshNumber(board, change.index);
+        refreshUnknown(board, change.index);
+        Topology::forEachNeighbor(change.index, board.width(), board.height(), [&](int neighbor) {
+            refreshNumber(board, neighbor);
+        });
+        touch(change.index);
+    }
+}
+
+// Keeps touched bounded by the cell count however long it goes without being drained
+template <typename Topology>
+void Frontier<Topology>::touch(int index) {
+    if (!isTouched[index]) {
+        isTouched[index] = true;
+        touched.append(index);
+    }
+}
+
+template <typename Topology>
+bool Frontier<Topology>::shouldBeNumber(const BoardState& board, int index) const {
+    if (!board.isRevealed(index) || board.isBomb(index) || board.adjacentBombs(index) == 0) {
+        return false;
+    }
+    bool open = false;
+    Topology::forEachNeighbor(index, board.width(), board.height(), [&](int neighbor) {
+        open = open || isOpen(board, neighbor);
+    });
+    return open;
+}
+
+// Adding or removing a number updates the neighbor counts that decide unknown membership
+// Cells of a diff are refreshed in any order, so a cell may still hold its old role here
+template <typename Topology>
+void Frontier<Topology>::refreshNumber(const BoardState& board, int index) {
+    bool should = shouldBeNumber(board, index);
+    if (should == isNumber(index)) {
+        return;
+    }
+    if (should) {
+        if (isUnknown(index)) {
+            remove(unknownList, index);
+        }
+        insert(numberList, true, index);
+    } else {
+        remove(numberList, index);
+    }
+    touch(index);
+    Topology::forEachNeighbor(index, board.width(), board.height(), [&](int neighbor) {
+        adjacentNumbers[neighbor] += should ? 1 : -1;
+        refreshUnknown(board, neighbor);
+    });
+    if (!should) {
+        refreshUnknown(board, index);
+    }
+}
+
+template <typename Topology>
+void Frontier<Topology>::refreshUnknown(const BoardState& board, int index) {
+    bool should = adjacentNumbers[index] > 0 && isOpen(board, index);
+    if (should == isUnknown(index)) {
+        return;
+    }
+    if (should && isNumber(index)) {
+        // A hidden-again number must leave the number list first, which re-runs this check
+        refreshNumber(board, index);
+        return;
+    }
+    if (should) {
+        insert(unknownList, false, index);
+    } else {
+        remove(unknownList, index);
+    }
+    touch(index);
+}
+
+template <typename Topology>
+void Frontier<Topology>::insert(QVector<int>& list, bool number, int index) {
+    slot[index] = list.size();
+    isNumberSlot[index] = number;
+    list.append(index);
+}
+
+// Swaps the last member into the removed slot so removal stays O(1)
+template <typename Topology>
+void Frontier<Topology>::remove(QVector<int>& list, int index) {
+    int position = slot[index];
+    int last = list.last();
+    list[position] = last;
+    slot[last] = position;
+    list.removeLast();
+    slot[index] = -1;
+}
+
+template <typename Topology>
+QVector<FrontierComponent> Frontier<Topology>::components(const BoardState& board) const {
+    QVector<FrontierComponent> result;
+    QSet<int> visited;
+    for (int index : numberList) {
+        if (!visited.contains(index)) {
+            result.append(collect(board, index, visited));
+        }
+    }
+    return result;
+}
+
+template <typename Topology>
+QVector<FrontierComponent> Frontier<Topology>::takeChangedComponents(const BoardState& board) {
+    QVector<FrontierComponent> result;
+    QSet<int> visited;
+    for (int index : touched) {
+        isTouched[index] = false;
+        if (slot[index] >= 0 && !visited.contains(index)) {
+            result.append(collect(board, index, visited));
+        }
+        // A cell that left the frontier or changed role may have split off the components of its neighbors
+        Topology::forEachNeighbor(index, board.width(), board.height(), [&](int neighbor) {
+            if (slot[neighbor] >= 0 && !visited.contains(neighbor)) {
+                result.append(collect(board, neighbor, visited));
+            }
+        });
+    }
+    touched.clear();
+    return result;
+}
+
+// Walks number -> unknown -> number links from one frontier cell
+template <typename Topology>
+FrontierComponent Frontier<Topology>::collect(const BoardState& board, int start, QSet<int>& visited) const {
+    FrontierComponent component;
+    QVector<int> stack;
+    stack.append(start);
+    visited.insert(start);
+    while (!stack.isEmpty()) {
+        int index = stack.takeLast();
+        bool number = isNumber(index);
+        (number ? component.numbers : component.unknowns).append(index);
+        Topology::forEachNeighbor(index, board.width(), board.height(), [&](int neighbor) {
+            bool linked = number ? isUnknown(neighbor) : isNumber(neighbor);
+            if (linked && !visited.contains(neighbor)) {
+                visited.insert(neighbor);
+                stack.append(neighbor);
+            }
+        });
+    }
+    return component;
+}
+
+#endif //MINE_SWEEPER_FRONTIER_H
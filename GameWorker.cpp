@@ -0,0 +1,205 @@
+#include "GameWorker.h"
+#include "BoardFile.h"
+#include "BoardMetrics.h"
+#include "BoardStream.h"
+#include <cstdio>
+#include <QDateTime>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QtConcurrent>
+
+GameWorker::GameWorker(QObject *parent) : QObject(parent) {
+}
+
+// Generates the board on the worker thread so large boards never stall the GUI
+void GameWorker::newGame(int width, int height, int bombCount, int lives, quint32 seed) {
+    board.generate(width, height, bombCount, lives, seed);
+    startTracking();
+    emit boardReady(board.snapshot());
+    autosave();
+    pregenerate();
+}
+
+// Swaps in the layout generated while the previous game was played
+void GameWorker::restartGame() {
+    // A default-constructed future reports itself as canceled
+    Board next = nextBoard.isCanceled() ? Board() : nextBoard.result();  // Only blocks right after a new game
+    if (next.width() == board.width() && next.height() == board.height()) {
+        board.restart(next);
+    } else {
+        board.generate(board.width(), board.height(), board.bombTotal(), board.maxLives(), QRandomGenerator::global()->generate());
+    }
+    startTracking();
+    emit boardReady(board.snapshot());
+    autosave();
+    pregenerate();
+}
+
+void GameWorker::pregenerate() {
+    int width = board.width();
+    int height = board.height();
+    int bombCount = board.bombTotal();
+    int lives = board.maxLives();
+    quint32 seed = QRandomGenerator::global()->generate();
+    nextBoard = QtConcurrent::run([width, height, bombCount, lives, seed]() {
+        Board next;
+        next.generate(width, height, bombCount, lives, seed);
+        return next;
+    });
+}
+
+// Runs the reveal flood-fill and sends back only the changed cells
+void GameWorker::reveal(int index) {
+    BoardDiff diff = board.reveal(index);
+    if (!diff.cells.isEmpty()) {
+        countClick();
+        recordResult(diff);
+        emit boardChanged(diff);
+        autosave();
+    }
+}
+
+// Clears around a number whose bombs are all flagged
+void GameWorker::chord(int index) {
+    BoardDiff diff = board.chord(index);
+    if (!diff.cells.isEmpty()) {
+        countClick();
+        recordResult(diff);
+        emit boardChanged(diff);
+        autosave();
+    }
+}
+
+// Updates the mark of a single cell
+void GameWorker::toggleMark(int index) {
+    BoardDiff diff = board.toggleMark(index);
+    if (!diff.cells.isEmpty()) {
+        countClick();
+        emit boardChanged(diff);
+        autosave();
+    }
+}
+
+// Steps back through the board's journal
+void GameWorker::undo() {
+    BoardDiff diff = board.undo();
+    if (!diff.cells.isEmpty()) {
+        emit boardChanged(diff);
+        autosave();
+    }
+}
+
+// Steps forward through the board's journal
+void GameWorker::redo() {
+    BoardDiff diff = board.redo();
+    if (!diff.cells.isEmpty()) {
+        recordResult(diff);
+        emit boardChanged(diff);
+        autosave();
+    }
+}
+
+void GameWorker::setSavePath(const QString& path) {
+    savePath = path;
+}
+
+void GameWorker::setStatsPath(const QString& directory) {
+    if (directory.isEmpty()) {
+        stats.close();
+    } else {
+        stats.open(directory);
+    }
+}
+
+void GameWorker::setMaxGridSize(const QSize& size) {
+    maxGridSize = size;
+}
+
+bool GameWorker::fitsGrid(const Board& candidate) const {
+    return maxGridSize.isEmpty()
+            || (candidate.width() <= maxGridSize.width() && candidate.height() <= maxGridSize.height());
+}
+
+void GameWorker::startTracking() {
+    gameTimer.invalidate();
+    clicks = 0;
+    recorded = false;
+}
+
+void GameWorker::countClick() {
+    if (!gameTimer.isValid()) {
+        gameTimer.start();
+    }
+    ++clicks;
+}
+
+// A game is recorded once, even if the ending move is undone and the game continues
+void GameWorker::recordResult(const BoardDiff& diff) {
+    if (recorded || (diff.outcome != MoveOutcome::Won && diff.outcome != MoveOutcome::OutOfLives)) {
+        return;
+    }
+    recorded = true;
+    // Undo can take back mine hits, so such games would skew win rates and lives lost
+    if (!stats.isOpen() || board.undoUsed()) {
+        return;
+    }
+    StatsRecord record;
+    record.seed = board.seed();
+    record.maxLives = board.maxLives();
+    record.durationMs = gameTimer.isValid() ? quint32(gameTimer.elapsed()) : 0;
+    record.clicks = clicks;
+    record.bbbv = BoardMetrics::measure(board).bbbv;
+    record.livesLost = quint16(board.maxLives() - board.lives());
+    record.won = diff.outcome == MoveOutcome::Won;
+    record.finishedAt = QDateTime::currentMSecsSinceEpoch();
+    stats.append(record);
+}
+
+// Restores the autosaved game, or reports that there is nothing usable to continue
+void GameWorker::loadGame() {
+    if (savePath.isEmpty() || !BoardFile::load(board, savePath) || board.isOver()) {
+        emit loadFailed();
+        return;
+    }
+    // The save is kept, since it still opens on a larger screen
+    if (!fitsGrid(board)) {
+        emit boardTooLarge(board.width(), board.height());
+        return;
+    }
+    startTracking();
+    emit boardReady(board.snapshot());
+    pregenerate();
+}
+
+// Finished games are not worth continuing, so their save is removed
+void GameWorker::autosave() {
+    if (savePath.isEmpty()) {
+        return;
+    }
+    if (board.isOver()) {
+        QFile::remove(savePath);
+    } else {
+        BoardFile::save(board, savePath);
+    }
+}
+
+// Reads into a scratch board so a malformed file leaves the current game untouched
+void GameWorker::importGame(const QString& path, int lives) {
+    QFile file(path);
+    bool opened = path == "-" ? file.open(stdin, QIODevice::ReadOnly) : file.open(QIODevice::ReadOnly);
+    Board imported;
+    if (!opened || !BoardStream::read(imported, file, BoardStream::formatForPath(path), lives)) {
+        emit loadFailed();
+        return;
+    }
+    // Checked before autosave(), which would otherwise replace the player's save with a board they cannot open
+    if (!fitsGrid(imported)) {
+        emit boardTooLarge(imported.width(), imported.height());
+        return;
+    }
+    board = std::move(imported);
+    startTracking();
+    emit boardReady(board.snapshot());
+    autosave();
+    pregenerate();
+}
@@ -0,0 +1,147 @@
+#ifndef MINE_SWEEPER_GAMEWORKER_H
+#define MINE_SWEEPER_GAMEWORKER_H
+
+#include <QObject>
+#include <QFuture>
+#include <QElapsedTimer>
+#include <QSize>
+#include "Board.h"
+#include "StatsStore.h"
+
+/**
+ * @brief The GameWorker class owns the board and runs every game command off the GUI thread
+ * Commands arrive as queued slot calls and results are published back as snapshots and diffs
+ */
+class GameWorker : public QObject {
+Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for the game worker
+     * @param parent Parent object (must be nullptr to move the worker to another thread)
+     */
+    explicit GameWorker(QObject *parent = nullptr);
+
+public slots:
+    /**
+     * @brief Generates a new board and publishes its snapshot
+     * @param width Width of the game grid
+     * @param height Height of the game grid
+     * @param bombCount Total number of bombs in the game
+     * @param lives Number of lives for the game
+     * @param seed Seed for bomb placement
+     */
+    void newGame(int width, int height, int bombCount, int lives, quint32 seed);
+
+    /**
+     * @brief Reveals a cell and publishes the cells that changed
+     * @param index Index of the cell to reveal
+     */
+    void reveal(int index);
+
+    /**
+     * @brief Cycles the mark of a cell and publishes the cell that changed
+     * @param index Index of the cell to mark
+     */
+    void toggleMark(int index);
+
+    /**
+     * @brief Reveals the open neighbors of a fully flagged number and publishes the cells that changed
+     * @param index Index of a revealed numbered cell
+     */
+    void chord(int index);
+
+    /**
+     * @brief Starts a new game with the current settings and publishes its snapshot
+     */
+    void restartGame();
+
+    /**
+     * @brief Reverts the last move and publishes the cells that changed
+     */
+    void undo();
+
+    /**
+     * @brief Reapplies the last undone move and publishes the cells that changed
+     */
+    void redo();
+
+    /**
+     * @brief Sets the file used to autosave the game after every move
+     * @param path Path of the save file (empty disables autosave)
+     */
+    void setSavePath(const QString& path);
+
+    /**
+     * @brief Sets the directory of the statistics log that finished games are recorded in
+     * @param directory Directory of the log (empty disables statistics)
+     */
+    void setStatsPath(const QString& directory);
+
+    /**
+     * @brief Sets the largest grid the GUI can show; larger saved or imported boards are refused
+     * @param size Largest width and height in cells (an empty size disables the limit)
+     */
+    void setMaxGridSize(const QSize& size);
+
+    /**
+     * @brief Loads the autosaved game and publishes its snapshot
+     */
+    void loadGame();
+
+    /**
+     * @brief Replaces the game with a bomb layout read from a text or JSON board file
+     * @param path Path of the board file, or "-" for standard input
+     * @param lives Number of lives for the imported game
+     */
+    void importGame(const QString& path, int lives);
+
+signals:
+    void boardReady(const BoardSnapshot& snapshot);
+    void boardChanged(const BoardDiff& diff);
+    void loadFailed();
+    void boardTooLarge(int width, int height);
+
+private:
+    Board board;        // Game state, only touched from the worker thread
+    QString savePath;   // Autosave file, empty when autosave is off
+    QSize maxGridSize;  // Largest board the GUI can show, empty for no limit
+    QFuture<Board> nextBoard;   // Next layout with the current settings, built on the thread pool
+    StatsStore stats;           // Log of finished games
+    QElapsedTimer gameTimer;    // Started by the first click of a game
+    quint32 clicks = 0;         // Reveals, chords and marks in the current game
+    bool recorded = false;      // True once the current game is in the log
+
+    /**
+     * @brief Starts generating the layout for the next restart in the background
+     * The layout is as random as one from newGame(), so restarts and new games are equally hard
+     */
+    void pregenerate();
+
+    /**
+     * @brief Resets the click count and timer for a newly published board
+     */
+    void startTracking();
+
+    /**
+     * @brief Counts a player click, starting the game timer on the first one
+     */
+    void countClick();
+
+    /**
+     * @brief Records the game in the statistics log the first time a move ends it
+     */
+    void recordResult(const BoardDiff& diff);
+
+    /**
+     * @brief Returns true if the board fits in maxGridSize
+     */
+    bool fitsGrid(const Board& candidate) const;
+
+    /**
+     * @brief Writes the changed chunks of an ongoing game, or drops the save once the game is over
+     */
+    void autosave();
+};
+
+#endif //MINE_SWEEPER_GAMEWORKER_H
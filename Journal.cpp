@@ -0,0 +1,69 @@
+#include "Journal.h"
+#include <algorithm>
+
+qint64 JournalEntry::cost() const {
+    return qint64(sizeof(JournalEntry)) + (spans.size() + clearedMarks.size()) * qint64(sizeof(int));
+}
+
+Journal::Journal(qint64 budgetBytes) : budget(budgetBytes) {
+}
+
+// Appends a move after dropping the redo tail
+void Journal::record(JournalEntry entry) {
+    while (entries.size() > cursor) {
+        bytes -= entries.last().cost();
+        entries.removeLast();
+    }
+    entry.spans.squeeze();
+    entry.clearedMarks.squeeze();
+    bytes += entry.cost();
+    entries.append(std::move(entry));
+    ++cursor;
+    compact();
+}
+
+const JournalEntry* Journal::undo() {
+    if (cursor == 0) {
+        return nullptr;
+    }
+    return &entries[--cursor];
+}
+
+const JournalEntry* Journal::redo() {
+    if (cursor == entries.size()) {
+        return nullptr;
+    }
+    return &entries[cursor++];
+}
+
+void Journal::clear() {
+    entries.clear();
+    cursor = 0;
+    bytes = 0;
+}
+
+// The newest move is always kept, even if it alone exceeds the budget
+void Journal::compact() {
+    while (bytes > budget && entries.size() > 1) {
+        bytes -= entries.first().cost();
+        entries.removeFirst();
+        --cursor;
+    }
+}
+
+// Sorts the indices and merges consecutive ones into runs
+QVector<int> Journal::toSpans(QVector<int> indices) {
+    std::sort(indices.begin(), indices.end());
+    QVector<int> spans;
+    for (int i = 0; i < indices.size();) {
+        int start = indices[i];
+        int length = 1;
+        while (i + length < indices.size() && indices[i + length] == start + length) {
+            ++length;
+        }
+        spans.append(start);
+        spans.append(length);
+        i += length;
+    }
+    return spans;
+}
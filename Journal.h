@@ -0,0 +1,77 @@
+#ifndef MINE_SWEEPER_JOURNAL_H
+#define MINE_SWEEPER_JOURNAL_H
+
+#include <QVector>
+#include <QList>
+
+/**
+ * @brief One reversible move, stored as the delta it applied to the board
+ * Revealed cells are kept as sorted (start, length) runs, so a flood fill
+ * costs a few integers per row it touched rather than one object per cell
+ */
+struct JournalEntry {
+    int livesBefore = 0;            // Lives before the move
+    int livesAfter = 0;             // Lives after the move
+    int markIndex = -1;             // Cell whose mark was cycled, or -1 for a reveal
+    quint8 markBefore = 0;          // Mark of markIndex before the move
+    QVector<int> spans;             // Revealed cells as (start, length) pairs
+    QVector<int> clearedMarks;      // Marks removed by the reveal as (index, mark) pairs
+
+    /**
+     * @brief Approximate memory held by the entry, used for the journal budget
+     */
+    qint64 cost() const;
+};
+
+/**
+ * @brief The Journal class keeps the undo/redo history of a board
+ * When the history grows past its memory budget the oldest moves are dropped
+ */
+class Journal {
+public:
+    /**
+     * @brief Constructor for the journal
+     * @param budgetBytes Memory the history may hold before old moves are dropped
+     */
+    explicit Journal(qint64 budgetBytes = 64 * 1024 * 1024);
+
+    /**
+     * @brief Records a new move, discarding any moves that could have been redone
+     */
+    void record(JournalEntry entry);
+
+    /**
+     * @brief Steps back one move
+     * @return The move to revert, or nullptr if there is nothing to undo
+     */
+    const JournalEntry* undo();
+
+    /**
+     * @brief Steps forward one move
+     * @return The move to reapply, or nullptr if there is nothing to redo
+     */
+    const JournalEntry* redo();
+
+    /**
+     * @brief Forgets the whole history
+     */
+    void clear();
+
+    /**
+     * @brief Builds sorted (start, length) runs from a list of cell indices
+     */
+    static QVector<int> toSpans(QVector<int> indices);
+
+private:
+    QList<JournalEntry> entries;   // Oldest move first
+    int cursor = 0;                // Number of moves currently applied
+    qint64 bytes = 0;              // Sum of cost() over entries
+    qint64 budget;                 // Memory limit for entries
+
+    /**
+     * @brief Drops the oldest applied moves until the history fits the budget
+     */
+    void compact();
+};
+
+#endif //MINE_SWEEPER_JOURNAL_H
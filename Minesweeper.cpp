@@ -1,4 +1,5 @@
 #include "Minesweeper.h"
+#include "GameWorker.h"
 #include <QRandomGenerator>
 #include <QMessageBox>
 #include <QDebug>
@@ -8,6 +9,10 @@
 #include <QVBoxLayout>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QShortcut>
 
 // Add these constants at the class level
 const QString BASE_BUTTON_STYLE = "QPushButton { background-color: #c0c0c0; border: 1px solid #808080; }"
@@ -22,10 +27,68 @@ Minesweeper::Minesweeper(QWidget *parent) : QWidget(parent) {
                  "QMainWindow { border: none; background: black; }");
     setFixedSize(800, 600);  // Set initial size for menu
     setWindowFlags(Qt::FramelessWindowHint | Qt::WindowSystemMenuHint | Qt::WindowMinimizeButtonHint | Qt::WindowCloseButtonHint);
-    
+
+    // Run the game engine on its own thread; commands and results cross as queued signals
+    qRegisterMetaType<BoardDiff>("BoardDiff");
+    qRegisterMetaType<BoardSnapshot>("BoardSnapshot");
+    worker = new GameWorker;
+    worker->moveToThread(&workerThread);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(this, &Minesweeper::newGameRequested, worker, &GameWorker::newGame);
+    connect(this, &Minesweeper::restartRequested, worker, &GameWorker::restartGame);
+    connect(this, &Minesweeper::revealRequested, worker, &GameWorker::reveal);
+    connect(this, &Minesweeper::chordRequested, worker, &GameWorker::chord);
+    connect(this, &Minesweeper::markRequested, worker, &GameWorker::toggleMark);
+    connect(worker, &GameWorker::boardReady, this, &Minesweeper::onBoardReady);
+    connect(worker, &GameWorker::boardChanged, this, &Minesweeper::onBoardChanged);
+    connect(this, &Minesweeper::loadRequested, worker, &GameWorker::loadGame);
+    connect(this, &Minesweeper::undoRequested, worker, &GameWorker::undo);
+    connect(this, &Minesweeper::redoRequested, worker, &GameWorker::redo);
+    connect(this, &Minesweeper::importRequested, worker, &GameWorker::importGame);
+    connect(worker, &GameWorker::loadFailed, this, &Minesweeper::showMainMenu);
+    connect(worker, &GameWorker::boardTooLarge, this, &Minesweeper::onBoardTooLarge);
+
+    // Autosave the game in progress so quitting does not lose it
+    QString saveDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(saveDir);
+    savePath = saveDir + "/autosave.msb";
+    worker->setSavePath(savePath);  // Safe to call directly before the thread starts
+    worker->setStatsPath(saveDir + "/stats");
+    worker->setMaxGridSize(maxGridSize());
+
+    workerThread.start();
+
+    // Undo/redo the last move; ignored while the menu is shown
+    QShortcut* undoShortcut = new QShortcut(QKeySequence::Undo, this);
+    QShortcut* redoShortcut = new QShortcut(QKeySequence::Redo, this);
+    connect(undoShortcut, &QShortcut::activated, this, [this]() {
+        if (!buttons.isEmpty()) emit undoRequested();
+    });
+    connect(redoShortcut, &QShortcut::activated, this, [this]() {
+        if (!buttons.isEmpty()) emit redoRequested();
+    });
+    // Redo is Ctrl+Shift+Z on X11 and macOS, so add Ctrl+Y where the platform lacks it
+    QKeySequence ctrlY(Qt::CTRL | Qt::Key_Y);
+    if (!QKeySequence::keyBindings(QKeySequence::Redo).contains(ctrlY)) {
+        QShortcut* ctrlYShortcut = new QShortcut(ctrlY, this);
+        connect(ctrlYShortcut, &QShortcut::activated, redoShortcut, &QShortcut::activated);
+    }
+
+    // F2 restarts with the same settings, as in the classic game
+    QShortcut* restartShortcut = new QShortcut(QKeySequence(Qt::Key_F2), this);
+    connect(restartShortcut, &QShortcut::activated, this, [this]() {
+        if (!buttons.isEmpty()) resetGame();
+    });
+
     showMainMenu();
 }
 
+// Stops the worker thread; the worker itself is deleted when the thread finishes
+Minesweeper::~Minesweeper() {
+    workerThread.quit();
+    workerThread.wait();
+}
+
 // Centers the window on the screen based on screen geometry
 void Minesweeper::centerWindow() {
     // Get the screen geometry
@@ -96,6 +159,16 @@ void Minesweeper::showMainMenu() {
                              "QPushButton { background-color: #c0c0c0; }" // Gray
                              "QPushButton:hover { background-color: #d0d0d0; }");
 
+    // Offer to resume an autosaved game
+    if (QFile::exists(savePath)) {
+        QPushButton* continueButton = new QPushButton("Continue", this);
+        continueButton->setStyleSheet(baseButtonStyle +
+                                     "QPushButton { background-color: #ADD8E6; }" // Light blue
+                                     "QPushButton:hover { background-color: #C6E2EE; }"); // Lighter blue
+        connect(continueButton, &QPushButton::clicked, this, [this]() { continueGame(); });
+        mainLayout->addWidget(continueButton);
+    }
+
     // Connect buttons to their respective slots
     connect(easyButton, &QPushButton::clicked, this, [this]() { startGame(4); });
     connect(mediumButton, &QPushButton::clicked, this, [this]() { startGame(2); });
@@ -118,7 +191,34 @@ void Minesweeper::showMainMenu() {
 void Minesweeper::startGame(int lives) {
     maxLives = lives;
     currentLives = lives;
-    
+    width = DefaultWidth;
+    height = DefaultHeight;
+    bombCount = DefaultBombCount;
+
+    showGameBoard();
+    boardPending = true;
+    emit newGameRequested(width, height, bombCount, lives, QRandomGenerator::global()->generate());
+}
+
+// Shows the grid and asks the worker for the autosaved game
+void Minesweeper::continueGame() {
+    showGameBoard();
+    boardPending = true;
+    emit loadRequested();
+}
+
+// Shows the grid and asks the worker to read the board file
+void Minesweeper::importGame(const QString& path, int lives) {
+    maxLives = lives;
+    currentLives = lives;
+
+    showGameBoard();
+    boardPending = true;
+    emit importRequested(path, lives);
+}
+
+// Swaps the menu for an empty game grid
+void Minesweeper::showGameBoard() {
     // Clear the menu layout
     if (layout()) {
         QLayout* oldLayout = layout();
@@ -127,16 +227,24 @@ void Minesweeper::startGame(int lives) {
 
     // Initialize the game
     initializeGrid();
-    
+
     // Calculate the window size based on the grid dimensions
-    int windowWidth = (width * 40) + 20 + 4;
-    int windowHeight = (height * 40) + 20 + 4;
-    setFixedSize(windowWidth, windowHeight);
+    setFixedSize(windowSizeFor(width, height));
     
     // Center the window
     centerWindow();
 }
 
+QSize Minesweeper::windowSizeFor(int gridWidth, int gridHeight) {
+    return QSize(gridWidth * 40 + 20 + 4, gridHeight * 40 + 20 + 4);
+}
+
+// Every cell is a 40px button, so the grid is limited by the screen, not by the engine
+QSize Minesweeper::maxGridSize() {
+    QSize available = QGuiApplication::primaryScreen()->availableGeometry().size();
+    return QSize(qMax(1, (available.width() - 24) / 40), qMax(1, (available.height() - 24) / 40));
+}
+
 // Sets up the game grid with buttons and connects signals/slots
 void Minesweeper::initializeGrid() {
     QGridLayout *gridLayout = new QGridLayout(this);
@@ -146,29 +254,8 @@ void Minesweeper::initializeGrid() {
     gridLayout->setContentsMargins(10, 10, 10, 10);
 
     buttons.resize(width * height);
-    bombs.resize(width * height);
-    bombCounts.resize(width * height);
-
-    placeBombs();
-    calculateBombCounts();
-
-    // Pre-calculate neighbor indices
-    neighborIndices.resize(width * height);
-    for (int row = 0; row < height; ++row) {
-        for (int col = 0; col < width; ++col) {
-            int index = row * width + col;
-            for (int dr = -1; dr <= 1; ++dr) {
-                for (int dc = -1; dc <= 1; ++dc) {
-                    if (dr == 0 && dc == 0) continue;
-                    int newRow = row + dr;
-                    int newCol = col + dc;
-                    if (newRow >= 0 && newRow < height && newCol >= 0 && newCol < width) {
-                        neighborIndices[index].append(newRow * width + newCol);
-                    }
-                }
-            }
-        }
-    }
+    shownViews.resize(width * height);
+    shownViews.fill(CellHidden);
 
     for (int row = 0; row < height; ++row) {
         for (int col = 0; col < width; ++col) {
@@ -181,11 +268,6 @@ void Minesweeper::initializeGrid() {
             // Add initial styling here
             button->setStyleSheet(BASE_BUTTON_STYLE);
 
-            button->setProperty("isBomb", bombs[index]);
-            button->setProperty("bombCount", bombCounts[index]);
-            button->setProperty("revealed", false);
-            button->setProperty("markState", 0);
-
             connect(button, &QPushButton::clicked, this, [this, row, col]() {
                 revealCell(row, col);
             });
@@ -200,189 +282,86 @@ void Minesweeper::initializeGrid() {
     setLayout(gridLayout);
 }
 
-// Randomly places bombs on the grid
-void Minesweeper::placeBombs() {
-    bombs.fill(false);
-    int placedBombs = 0;
-    while (placedBombs < bombCount) {
-        int index = QRandomGenerator::global()->bounded(width * height);
-        if (!bombs[index]) {
-            bombs[index] = true;
-            ++placedBombs;
-        }
-    }
-}
-
-// Calculates the number of adjacent bombs for each cell
-void Minesweeper::calculateBombCounts() {
-    bombCounts.fill(0);
-    for (int row = 0; row < height; ++row) {
-        for (int col = 0; col < width; ++col) {
-            int index = row * width + col;
-            if (bombs[index]) continue;
-
-            int count = 0;
-            for (int dr = -1; dr <= 1; ++dr) {
-                for (int dc = -1; dc <= 1; ++dc) {
-                    int newRow = row + dr;
-                    int newCol = col + dc;
-                    if (newRow >= 0 && newRow < height && newCol >= 0 && newCol < width) {
-                        int neighborIndex = newRow * width + newCol;
-                        if (bombs[neighborIndex]) {
-                            ++count;
-                        }
-                    }
-                }
-            }
-            bombCounts[index] = count;
-        }
-    }
-}
-
-// Handles cell revelation when clicked
-// Implements flood-fill algorithm for empty cells
-// Manages life system and game over conditions
+// Forwards a left click to the game worker
+// Clicking a revealed number reveals its neighbors once all its bombs are flagged
 void Minesweeper::revealCell(int row, int col) {
     int index = row * width + col;
-    QPushButton *button = buttons[index];
-
-    if (button->property("revealed").toBool()) {
-        return;
+    if (shownViews[index] >= 1 && shownViews[index] <= 8) {
+        emit chordRequested(index);
+    } else {
+        emit revealRequested(index);
     }
-
-    button->setIcon(QIcon());
-    button->setProperty("markState", 0);
-
-    if (bombs[index]) {
-        currentLives--;  // Decrease lives
-        
-        button->setText("");
-        QIcon mineIcon("/home/jbava/projects/mine-sweeper/images/Mine.png");
-        button->setIcon(mineIcon);
-        button->setIconSize(QSize(30, 30));
-        button->setStyleSheet("QPushButton { background-color: red; border: 1px solid #808080; padding: 0; }");
-        button->setProperty("revealed", true);
-
-        if (currentLives <= 0) {
-            // Game Over
-            showCenteredMessageBox("Game Over!", "You're out of lives!", QMessageBox::Reset | QMessageBox::Close);
-        } else {
-            // Show remaining lives message
-            showCenteredMessageBox("Hit a Mine!", QString("Lives remaining: %1").arg(currentLives), QMessageBox::Ok);
-        }
-        return;
-    }
-
-    // Use a queue for BFS
-    QQueue<QPair<int, int>> queue;
-    queue.enqueue(qMakePair(row, col));
-
-    while (!queue.isEmpty()) {
-        QPair<int, int> current = queue.dequeue();
-        int curRow = current.first;
-        int curCol = current.second;
-        int curIndex = curRow * width + curCol;
-        QPushButton *curButton = buttons[curIndex];
-
-        // Skip already revealed cells
-        if (curButton->property("revealed").toBool()) {
-            continue;
-        }
-
-        // Clear any flags or question marks for revealed cells
-        curButton->setIcon(QIcon());
-        curButton->setProperty("markState", 0);
-
-        // Mark the cell as revealed and set its style
-        curButton->setProperty("revealed", true);
-        curButton->setStyleSheet(REVEALED_BUTTON_STYLE);
-
-        // Show the bomb count if the cell has adjacent bombs
-        int bombCount = bombCounts[curIndex];
-        if (bombCount > 0) {
-            curButton->setText(QString::number(bombCount));
-            curButton->setStyleSheet(REVEALED_NUMBER_STYLE);
-            continue;
-        }
-
-        // Enqueue all valid neighbors
-        for (int neighborIndex : neighborIndices[curIndex]) {
-            QPushButton *neighborButton = buttons[neighborIndex];
-
-            if (!neighborButton->property("revealed").toBool() && !bombs[neighborIndex]) {
-                queue.enqueue(qMakePair(neighborIndex / width, neighborIndex % width));
-            }
-        }
-    }
-    checkWin();
 }
 
-// Resets the game state while maintaining the current difficulty
+// Requests a new board with the current difficulty
+// Buttons are redrawn from the new snapshot, which only touches cells that were played
 void Minesweeper::resetGame() {
     currentLives = maxLives;  // Reset to the current difficulty's lives
-    
-    // Clear existing state
-    bombs.fill(false);
-    bombCounts.fill(0);
-
-    // Reset all buttons
-    for (auto* button : buttons) {
-        resetButton(button);
-    }
+    boardPending = true;
+    emit restartRequested();
+}
 
-    placeBombs();
-    calculateBombCounts();
+// Forwards a right click (flag -> question mark -> unmarked) to the game worker
+void Minesweeper::handleRightClick(int row, int col) {
+    emit markRequested(row * width + col);
 }
 
-// Verifies if all non-bomb cells are revealed for win condition
-// Displays win message and handles game restart
-bool Minesweeper::checkWin() {
-    // Check if all non-bomb cells are revealed
-    for (int i = 0; i < buttons.size(); ++i) {
-        if (!bombs[i] && !buttons[i]->property("revealed").toBool()) {
-            return false;
-        }
+// Draws a freshly generated board
+void Minesweeper::onBoardReady(const BoardSnapshot& snapshot) {
+    boardPending = false;
+    maxLives = snapshot.maxLives;
+    currentLives = snapshot.lives;
+    bombCount = snapshot.bombCount;
+    if (buttons.isEmpty()) {
+        return;  // Back in the menu, nothing to draw
     }
 
-    // Create message box with restart option
-    showCenteredMessageBox("Congratulations!", "You've won the game!", QMessageBox::Reset | QMessageBox::Close);
-
-    return true;
+    // Loaded and imported boards may not match the grid on screen; the worker already refused any that do not fit
+    if (snapshot.width != width || snapshot.height != height) {
+        width = snapshot.width;
+        height = snapshot.height;
+        showGameBoard();
+    }
+    for (int index = 0; index < snapshot.cells.size(); ++index) {
+        applyCellView(index, snapshot.cells[index]);
+    }
 }
 
-// Handles right-click cell marking (flag -> question mark -> unmarked)
-void Minesweeper::handleRightClick(int row, int col) {
-    int index = row * width + col;
-    QPushButton *button = buttons[index];
+void Minesweeper::onBoardTooLarge(int boardWidth, int boardHeight) {
+    showMainMenu();
+    showCenteredMessageBox("Board Too Large",
+                           QString("A %1x%2 board does not fit on this screen.").arg(boardWidth).arg(boardHeight),
+                           QMessageBox::Ok);
+}
 
-    // Skip if already revealed
-    if (button->property("revealed").toBool()) {
+// Draws the cells changed by the last move
+// Manages life system and game over conditions
+void Minesweeper::onBoardChanged(const BoardDiff& diff) {
+    // Drop results for a board that is no longer shown
+    if (boardPending) {
         return;
     }
+    for (const CellChange& change : diff.cells) {
+        if (change.index < buttons.size()) {
+            applyCellView(change.index, change.view);
+        }
+    }
+    currentLives = diff.lives;
 
-    // Get current state of the button
-    int currentState = button->property("markState").toInt();
-    // Cycle through states: 0 -> 1 -> 2 -> 0
-    currentState = (currentState + 1) % 3;
-    // Set the new state
-    button->setProperty("markState", currentState);
-
-    switch (currentState) {
-        case 0: // Unmarked
-        {
-            resetButton(button);
+    switch (diff.outcome) {
+        case MoveOutcome::None:
             break;
-        }
-        case 1: // Flagged
-        {
-            setButtonIcon(button, "/home/jbava/projects/mine-sweeper/images/Flag.png");
+        case MoveOutcome::HitMine:
+            // Show remaining lives message
+            showCenteredMessageBox("Hit a Mine!", QString("Lives remaining: %1").arg(currentLives), QMessageBox::Ok);
             break;
-        }
-        case 2: // Question mark
-        {
-            setButtonIcon(button, "/home/jbava/projects/mine-sweeper/images/Mark.png");
+        case MoveOutcome::OutOfLives:
+            // Game Over
+            showCenteredMessageBox("Game Over!", "You're out of lives!", QMessageBox::Retry | QMessageBox::Reset | QMessageBox::Close);
+            break;
+        case MoveOutcome::Won:
+            showCenteredMessageBox("Congratulations!", "You've won the game!", QMessageBox::Retry | QMessageBox::Reset | QMessageBox::Close);
             break;
-        }
     }
 }
 
@@ -417,7 +396,9 @@ void Minesweeper::showCenteredMessageBox(const QString& title, const QString& te
 
     int ret = msgBox.exec();
     
-    if (buttons & QMessageBox::Reset && ret == QMessageBox::Reset) {
+    if (buttons & QMessageBox::Retry && ret == QMessageBox::Retry) {
+        resetGame();
+    } else if (buttons & QMessageBox::Reset && ret == QMessageBox::Reset) {
         showMainMenu();
     } else if (buttons & QMessageBox::Close && ret == QMessageBox::Close) {
         QApplication::quit();
@@ -427,9 +408,7 @@ void Minesweeper::showCenteredMessageBox(const QString& title, const QString& te
 void Minesweeper::resetButton(QPushButton* button) {
     button->setText("");
     button->setIcon(QIcon());
-    button->setProperty("revealed", false);
     button->setStyleSheet(BASE_BUTTON_STYLE);
-    button->setProperty("markState", 0);
 }
 
 void Minesweeper::setButtonIcon(QPushButton* button, const QString& iconPath) {
@@ -440,3 +419,37 @@ void Minesweeper::setButtonIcon(QPushButton* button, const QString& iconPath) {
     button->setStyleSheet(BASE_BUTTON_STYLE + "QPushButton { padding: 0; }");
 }
 
+void Minesweeper::applyCellView(int index, quint8 view) {
+    if (shownViews[index] == view) {
+        return;
+    }
+    shownViews[index] = view;
+
+    QPushButton* button = buttons[index];
+    switch (view) {
+        case CellHidden:
+            resetButton(button);
+            break;
+        case CellFlagged:
+            setButtonIcon(button, "/home/jbava/projects/mine-sweeper/images/Flag.png");
+            break;
+        case CellQuestioned:
+            setButtonIcon(button, "/home/jbava/projects/mine-sweeper/images/Mark.png");
+            break;
+        case CellMine:
+            setButtonIcon(button, "/home/jbava/projects/mine-sweeper/images/Mine.png");
+            button->setStyleSheet("QPushButton { background-color: red; border: 1px solid #808080; padding: 0; }");
+            break;
+        case 0:
+            button->setIcon(QIcon());
+            button->setText("");
+            button->setStyleSheet(REVEALED_BUTTON_STYLE);
+            break;
+        default:
+            // Show the bomb count if the cell has adjacent bombs
+            button->setIcon(QIcon());
+            button->setText(QString::number(view));
+            button->setStyleSheet(REVEALED_NUMBER_STYLE);
+            break;
+    }
+}
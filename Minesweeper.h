@@ -11,6 +11,10 @@
 #include <QScreen>
 #include <QGuiApplication>
 #include <QMessageBox>
+#include <QThread>
+#include "Board.h"
+
+class GameWorker;
 
 /**
  * @brief The Minesweeper class represents the main game window and logic
@@ -26,6 +30,18 @@ public:
      */
     explicit Minesweeper(QWidget *parent = nullptr);
 
+    /**
+     * @brief Starts a game on a bomb layout read from a board file
+     * @param path Path of a text or JSON board file, or "-" for standard input
+     * @param lives Number of lives for the game
+     */
+    void importGame(const QString& path, int lives);
+
+    /**
+     * @brief Destructor, stops the game worker thread
+     */
+    ~Minesweeper() override;
+
 protected:
     /**
      * @brief Handles mouse press events for window dragging
@@ -41,17 +57,22 @@ protected:
 
 private:
     QPoint dragPosition;        // Stores the position for window dragging
-    const int width = 30;       // Width of the game grid
-    const int height = 16;      // Height of the game grid
-    const int bombCount = 99;   // Total number of bombs in the game
+    static const int DefaultWidth = 30;      // Width of a new game grid
+    static const int DefaultHeight = 16;     // Height of a new game grid
+    static const int DefaultBombCount = 99;  // Bombs in a new game
+    int width = DefaultWidth;           // Width of the game grid
+    int height = DefaultHeight;         // Height of the game grid
+    int bombCount = DefaultBombCount;   // Total number of bombs in the game
     int maxLives;              // Maximum lives for current difficulty
     int currentLives;          // Current remaining lives
     QVector<QPushButton*> buttons;  // Grid buttons
-    QVector<bool> bombs;           // Bomb locations
-    QVector<int> bombCounts;       // Number of adjacent bombs for each cell
+    QVector<quint8> shownViews;     // CellView currently drawn on each button
     QWidget* mainMenu;            // Main menu widget
     QWidget* gameWidget;          // Game board widget
-    QVector<QVector<int>> neighborIndices;
+    QThread workerThread;         // Thread running the game engine
+    GameWorker* worker;           // Game engine, lives on workerThread
+    bool boardPending = false;    // True until the worker publishes the new board
+    QString savePath;             // Autosave file for the game in progress
 
     /**
      * @brief Initializes the game grid with buttons
@@ -59,33 +80,17 @@ private:
     void initializeGrid();
 
     /**
-     * @brief Places bombs randomly on the grid
-     */
-    void placeBombs();
-
-    /**
-     * @brief Calculates the number of adjacent bombs for each cell
-     */
-    void calculateBombCounts();
-
-    /**
-     * @brief Reveals a cell when clicked
+     * @brief Reveals a cell when clicked, or chords when the cell is a revealed number
      * @param row Row of the clicked cell
      * @param col Column of the clicked cell
      */
     void revealCell(int row, int col);
 
     /**
-     * @brief Resets the game to initial state
+     * @brief Starts a new game with the same settings
      */
     void resetGame();
 
-    /**
-     * @brief Checks if the player has won
-     * @return true if all non-bomb cells are revealed
-     */
-    bool checkWin();
-
     /**
      * @brief Handles right-click events for flagging cells
      * @param row Row of the right-clicked cell
@@ -104,6 +109,26 @@ private:
      */
     void startGame(int lives);
 
+    /**
+     * @brief Resumes the autosaved game
+     */
+    void continueGame();
+
+    /**
+     * @brief Replaces the current layout with an empty game grid sized to the board
+     */
+    void showGameBoard();
+
+    /**
+     * @brief Size of the window showing a grid of the given dimensions
+     */
+    static QSize windowSizeFor(int gridWidth, int gridHeight);
+
+    /**
+     * @brief Largest grid, in cells, whose window fits on the screen
+     */
+    static QSize maxGridSize();
+
     /**
      * @brief Centers the window on the screen
      */
@@ -114,8 +139,42 @@ private:
     void resetButton(QPushButton* button);
     void setButtonIcon(QPushButton* button, const QString& iconPath);
 
+    /**
+     * @brief Updates a button to show the given cell view, skipping buttons already showing it
+     * @param index Index of the cell's button
+     * @param view CellView value published by the engine
+     */
+    void applyCellView(int index, quint8 view);
+
+private slots:
+    /**
+     * @brief Redraws the whole grid from a snapshot published by the worker
+     * @param snapshot The board state after a new game was generated
+     */
+    void onBoardReady(const BoardSnapshot& snapshot);
+
+    /**
+     * @brief Redraws the changed cells and reacts to the outcome of a move
+     * @param diff The cells changed by the last move
+     */
+    void onBoardChanged(const BoardDiff& diff);
+
+    /**
+     * @brief Returns to the menu when a saved or imported board does not fit on the screen
+     */
+    void onBoardTooLarge(int boardWidth, int boardHeight);
+
 signals:
     void gameOver(bool win);
+    void newGameRequested(int width, int height, int bombCount, int lives, quint32 seed);
+    void restartRequested();
+    void revealRequested(int index);
+    void chordRequested(int index);
+    void markRequested(int index);
+    void loadRequested();
+    void undoRequested();
+    void redoRequested();
+    void importRequested(const QString& path, int lives);
 };
 
 #endif //MINE_SWEEPER_MINESWEEPER_H
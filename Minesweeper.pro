@@ -2,13 +2,37 @@
 TEMPLATE = app       # Type of project (application)
 CONFIG += qt gui     # Enable Qt and GUI support
 CONFIG -= app_bundle # Disable macOS app bundle (optional)
+CONFIG += c++17      # Compile-time pattern tables in Solver.h
 
 # Define the source files
 SOURCES += main.cpp \
-           Minesweeper.cpp
+           Minesweeper.cpp \
+           BoardState.cpp \
+           BoardMetrics.cpp \
+           BoardFile.cpp \
+           BoardStream.cpp \
+           GameWorker.cpp \
+           Journal.cpp \
+           StatsStore.cpp \
+           TournamentView.cpp \
+           TournamentWorker.cpp
 
 # Define the header files
-HEADERS += Minesweeper.h
+HEADERS += Minesweeper.h \
+           Board.h \
+           BoardState.h \
+           BoardMetrics.h \
+           BoardFile.h \
+           BoardStream.h \
+           Frontier.h \
+           GameWorker.h \
+           Journal.h \
+           Solver.h \
+           StatsStore.h \
+           Topology.h \
+           TournamentView.h \
+           TournamentWorker.h
 
 # Include additional Qt modules
-QT += widgets         # Include the Qt Widgets module
\ No newline at end of file
+QT += widgets         # Include the Qt Widgets module
+QT += concurrent      # Background board generation
\ No newline at end of file
@@ -0,0 +1,568 @@
+#ifndef MINE_SWEEPER_SOLVER_H
+#define MINE_SWEEPER_SOLVER_H
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <QVector>
+#include <array>
+#include <type_traits>
+#include "Board.h"
+
+/*
+ * Local pattern tables for the solver's fast path.
+ *
+ * The single table is generated at compile time. The pair table is 64K entries,
+ * more than the default constexpr budgets of clang and MSVC allow, so it is
+ * built once on first use instead. Either way the program holds a single copy
+ * however many files include this header. A key
+ * packs the number of bombs a revealed number still needs ("remaining": its
+ * count minus the flags and revealed mines around it) with a mask of the cells
+ * in its window that are still open. An entry holds a mask of the cells proven
+ * safe and, shifted by the window size, a mask of the cells proven to be bombs.
+ *
+ * Pair windows cover two side-by-side numbers A and B on a square grid:
+ * slots 0-2 touch only A, slots 3-6 touch both and slots 7-9 touch only B.
+ * The 1-2-1, 1-2-2-1 and corner patterns are chains of such pairs.
+ */
+namespace SolverPatterns {
+
+constexpr int SingleCells = 8;                  // The 8 neighbors of one number
+constexpr int SingleKeys = 9 << SingleCells;    // remaining 0-8, open mask
+constexpr int PairCells = 10;                   // Union of two neighboring numbers' neighbors
+constexpr int PairKeys = 1 << (6 + PairCells);  // remaining A and B 0-7, open mask
+
+constexpr int bitCount(quint32 value) {
+    int count = 0;
+    for (; value; value &= value - 1) {
+        ++count;
+    }
+    return count;
+}
+
+constexpr int singleKey(int remaining, quint32 open) {
+    return (remaining << SingleCells) | int(open);
+}
+
+constexpr int pairKey(int remainingA, int remainingB, quint32 open) {
+    return remainingA | (remainingB << 3) | int(open << 6);
+}
+
+constexpr quint32 singleEntry(int key) {
+    int remaining = key >> SingleCells;
+    quint32 open = quint32(key) & 0xff;
+    if (remaining == 0) {
+        return open;
+    } else if (remaining == bitCount(open)) {
+        return open << SingleCells;
+    }
+    return 0;
+}
+
+// With x bombs among the shared cells, A's own cells hold remainingA - x and B's hold remainingB - x.
+// A group is certain when it is empty or full for every feasible x.
+constexpr quint32 pairEntry(int key) {
+    int remainingA = key & 7;
+    int remainingB = (key >> 3) & 7;
+    quint32 open = quint32(key) >> 6;
+    quint32 onlyA = open & 0x007;
+    quint32 shared = open & 0x078;
+    quint32 onlyB = open & 0x380;
+    int sizeA = bitCount(onlyA);
+    int sizeShared = bitCount(shared);
+    int sizeB = bitCount(onlyB);
+
+    int lowest = -1;
+    int highest = -1;
+    for (int x = 0; x <= sizeShared; ++x) {
+        if (remainingA - x >= 0 && remainingA - x <= sizeA && remainingB - x >= 0 && remainingB - x <= sizeB) {
+            lowest = lowest < 0 ? x : lowest;
+            highest = x;
+        }
+    }
+    if (lowest < 0) {
+        return 0;   // Inconsistent with the flags; leave it to the general solver
+    }
+
+    quint32 safe = 0;
+    quint32 mines = 0;
+    if (remainingA - lowest == 0) safe |= onlyA;
+    if (remainingA - highest == sizeA) mines |= onlyA;
+    if (highest == 0) safe |= shared;
+    if (lowest == sizeShared) mines |= shared;
+    if (remainingB - lowest == 0) safe |= onlyB;
+    if (remainingB - highest == sizeB) mines |= onlyB;
+    return safe | (mines << PairCells);
+}
+
+template <int Keys, quint32 (*Entry)(int)>
+constexpr std::array<quint32, Keys> makeTable() {
+    std::array<quint32, Keys> table{};
+    for (int key = 0; key < Keys; ++key) {
+        table[key] = Entry(key);
+    }
+    return table;
+}
+
+inline constexpr std::array<quint32, SingleKeys> SingleTable = makeTable<SingleKeys, singleEntry>();
+
+// The table lives on the heap, so building it is cheap on the small stacks of worker threads
+inline const QVector<quint32>& pairTable() {
+    static const QVector<quint32> table = [] {
+        QVector<quint32> entries(PairKeys);
+        for (int key = 0; key < PairKeys; ++key) {
+            entries[key] = pairEntry(key);
+        }
+        return entries;
+    }();
+    return table;
+}
+
+// Window offsets (row, column) relative to number A, for B to the right of A and B below A
+inline constexpr int SingleOffsets[SingleCells][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+                                                      {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+inline constexpr int RightPairOffsets[PairCells][2] = {{-1, -1}, {0, -1}, {1, -1},
+                                                       {-1, 0}, {-1, 1}, {1, 0}, {1, 1},
+                                                       {-1, 2}, {0, 2}, {1, 2}};
+inline constexpr int DownPairOffsets[PairCells][2] = {{-1, -1}, {-1, 0}, {-1, 1},
+                                                      {0, -1}, {1, -1}, {0, 1}, {1, 1},
+                                                      {2, -1}, {2, 0}, {2, 1}};
+
+// Sanity checks on well-known configurations
+static_assert(singleEntry(singleKey(0, 0x0f)) == 0x0f, "a satisfied number clears its open neighbors");
+static_assert(singleEntry(singleKey(2, 0x03)) == 0x03 << SingleCells, "a number with as many open cells as bombs flags them");
+// 1-2 against a wall: A=1 sees shared cells 3-4, B=2 sees shared 3-4 and its own cell 7
+static_assert((pairEntry(pairKey(1, 2, 0x1 | 0x18 | 0x80)) & 0x1) == 0x1, "1-2: the cell only next to the 1 is safe");
+static_assert((pairEntry(pairKey(1, 2, 0x1 | 0x18 | 0x80)) >> PairCells) == 0x80, "1-2: the cell only next to the 2 is a bomb");
+
+} // namespace SolverPatterns
+
+/**
+ * @brief Counters for how often the pattern tables settled a position
+ */
+struct SolverStats {
+    quint64 lookups = 0;         // Table lookups made
+    quint64 hits = 0;            // Lookups that proved at least one cell
+    quint64 patternSolves = 0;   // solve() calls answered by the tables alone
+    quint64 generalSolves = 0;   // solve() calls that needed the general solver
+
+    SolverStats& operator+=(const SolverStats& other) {
+        lookups += other.lookups;
+        hits += other.hits;
+        patternSolves += other.patternSolves;
+        generalSolves += other.generalSolves;
+        return *this;
+    }
+};
+
+/**
+ * @brief The Solver class finds cells that are certainly safe or certainly bombs
+ *
+ * The fast path looks every frontier number and every pair of neighboring
+ * numbers up in the pattern tables. Only when that proves nothing does it fall
+ * back to enumerating the bomb layouts of each frontier component.
+ *
+ * The general solver keeps its result for each component and only searches the
+ * components the board reports as changed since the previous call, so a
+ * solver must not alternate between boards that are both still in play.
+ *
+ * @tparam Topology Policy from Topology.h; the pattern tables are used on SquareTopology boards only
+ */
+template <typename Topology>
+class Solver {
+public:
+    static const int MaxComponentUnknowns = 48;   // Larger components are skipped by the general solver
+    static const int MaxSearchNodes = 1 << 20;    // Backtracking budget per component
+
+    /**
+     * @brief Cells the solver proved on the current board
+     */
+    struct Deduction {
+        QVector<int> safe;    // Open cells without a bomb
+        QVector<int> mines;   // Open cells with a bomb
+
+        bool isEmpty() const { return safe.isEmpty() && mines.isEmpty(); }
+    };
+
+    /**
+     * @brief Enables or disables the pattern fast path, e.g. to measure its speedup
+     */
+    void setPatternsEnabled(bool enabled) { patternsEnabled = enabled; }
+
+    /**
+     * @brief Finds provably safe cells and bombs on the board's frontier
+     * @param board The board to solve; its changed frontier components are taken on every call
+     * @return The cells found, empty if the position needs a guess
+     */
+    Deduction solve(BasicBoard<Topology>& board);
+
+    /**
+     * @brief Plays the board to the end, revealing proven cells, flagging proven bombs and guessing otherwise
+     * @param board The board to play; give it enough lives to survive wrong guesses to count every guess
+     * @param guessSeed Seed for choosing guesses, so a playout can be repeated; it must differ from
+     *        the board's seed, or the guesses follow the bomb placement
+     * @return The number of guesses made, including the first click
+     */
+    int playOut(BasicBoard<Topology>& board, quint32 guessSeed);
+
+    const SolverStats& stats() const { return counters; }
+    void resetStats() { counters = SolverStats(); }
+
+private:
+    /**
+     * @brief A frontier component and, once the general solver has searched it, what it proves
+     */
+    struct CachedComponent {
+        FrontierComponent component;
+        bool solved = false;
+        Deduction result;
+    };
+
+    bool patternsEnabled = true;
+    SolverStats counters;
+    QHash<int, CachedComponent> cache;   // Components not searched yet or with proven cells left, keyed by their first number
+    QVector<int> owner;                  // Cache key of the entry holding each cell, -1 if none
+    QVector<bool> seen;                  // Cells already in the pattern result, all false between calls
+
+    static bool isOpen(const BoardState& board, int index) {
+        return !board.isRevealed(index) && board.mark(index) != 1;
+    }
+
+    /**
+     * @brief Bombs a revealed number still needs among its open neighbors
+     */
+    static int remaining(const BasicBoard<Topology>& board, int number);
+
+    /**
+     * @brief Replaces the cached components that changed since the previous call
+     */
+    void takeChanges(BasicBoard<Topology>& board);
+
+    /**
+     * @brief Releases the cells of an entry leaving the cache, so no cell keeps a key that may be reused
+     */
+    void forget(const CachedComponent& entry);
+
+    Deduction solvePatterns(const BasicBoard<Topology>& board);
+    Deduction solveGeneral(const BasicBoard<Topology>& board);
+    Deduction solveComponent(const BasicBoard<Topology>& board, const FrontierComponent& component) const;
+
+    /**
+     * @brief Mask of the open cells in a window, with cells off the board counted as closed
+     */
+    template <int Cells>
+    static quint32 openMask(const BoardState& board, int row, int col, const int (&offsets)[Cells][2]);
+
+    /**
+     * @brief Counts one table lookup and collects the cells its entry proves
+     * @param entry The table entry for the window at (row, col)
+     */
+    template <int Cells>
+    void lookUp(const BoardState& board, int row, int col, const int (&offsets)[Cells][2], quint32 entry,
+                Deduction& result);
+};
+
+template <typename Topology>
+int Solver<Topology>::remaining(const BasicBoard<Topology>& board, int number) {
+    int found = 0;
+    board.forEachNeighbor(number, [&](int neighbor) {
+        found += board.isRevealed(neighbor) ? board.isBomb(neighbor) : board.mark(neighbor) == 1;
+    });
+    return board.adjacentBombs(number) - found;
+}
+
+template <typename Topology>
+typename Solver<Topology>::Deduction Solver<Topology>::solve(BasicBoard<Topology>& board) {
+    takeChanges(board);
+    if constexpr (std::is_same<Topology, SquareTopology>::value) {
+        if (patternsEnabled) {
+            Deduction result = solvePatterns(board);
+            if (!result.isEmpty()) {
+                ++counters.patternSolves;
+                return result;
+            }
+        }
+    }
+    ++counters.generalSolves;
+    return solveGeneral(board);
+}
+
+// Claiming a cell for a new component drops the entry that owned it before, so entries never
+// share cells and the cache is bounded by the cell count
+template <typename Topology>
+void Solver<Topology>::takeChanges(BasicBoard<Topology>& board) {
+    if (owner.size() != board.cellCount()) {
+        cache.clear();
+        owner.fill(-1, board.cellCount());
+        seen.fill(false, board.cellCount());
+    }
+    for (const FrontierComponent& component : board.takeChangedComponents()) {
+        int key = component.numbers.first();   // Every component holds at least one number
+        for (const QVector<int>* cells : {&component.numbers, &component.unknowns}) {
+            for (int index : *cells) {
+                if (owner[index] >= 0) {
+                    forget(cache.take(owner[index]));
+                }
+                owner[index] = key;
+            }
+        }
+        CachedComponent entry;
+        entry.component = component;
+        cache.insert(key, entry);
+    }
+}
+
+template <typename Topology>
+void Solver<Topology>::forget(const CachedComponent& entry) {
+    for (const QVector<int>* cells : {&entry.component.numbers, &entry.component.unknowns}) {
+        for (int index : *cells) {
+            owner[index] = -1;
+        }
+    }
+}
+
+// Every window is read straight from the planes, so one lookup costs a handful of loads
+template <typename Topology>
+typename Solver<Topology>::Deduction Solver<Topology>::solvePatterns(const BasicBoard<Topology>& board) {
+    using namespace SolverPatterns;
+    const QVector<quint32>& pairs = pairTable();
+    Deduction result;
+    int width = board.width();
+    int height = board.height();
+
+    for (int number : board.frontier().numbers()) {
+        int row = number / width;
+        int col = number % width;
+        int needA = remaining(board, number);
+        if (needA < 0) {
+            continue;
+        }
+        lookUp(board, row, col, SingleOffsets, SingleTable[singleKey(needA, openMask(board, row, col, SingleOffsets))],
+               result);
+
+        // Pairs with the revealed number to the right and below; the other two directions are
+        // covered when the neighbor is the frontier number being visited
+        if (needA > 7) {
+            continue;
+        }
+        if (col + 1 < width && board.isRevealed(number + 1) && !board.isBomb(number + 1)) {
+            int needB = remaining(board, number + 1);
+            quint32 open = openMask(board, row, col, RightPairOffsets);
+            if (needB >= 0 && needB <= 7 && open != 0) {
+                lookUp(board, row, col, RightPairOffsets, pairs[pairKey(needA, needB, open)], result);
+            }
+        }
+        if (row + 1 < height && board.isRevealed(number + width) && !board.isBomb(number + width)) {
+            int needB = remaining(board, number + width);
+            quint32 open = openMask(board, row, col, DownPairOffsets);
+            if (needB >= 0 && needB <= 7 && open != 0) {
+                lookUp(board, row, col, DownPairOffsets, pairs[pairKey(needA, needB, open)], result);
+            }
+        }
+    }
+
+    for (const QVector<int>* cells : {&result.safe, &result.mines}) {
+        for (int index : *cells) {
+            seen[index] = false;
+        }
+    }
+    return result;
+}
+
+template <typename Topology>
+template <int Cells>
+quint32 Solver<Topology>::openMask(const BoardState& board, int row, int col, const int (&offsets)[Cells][2]) {
+    quint32 mask = 0;
+    for (int slot = 0; slot < Cells; ++slot) {
+        int r = row + offsets[slot][0];
+        int c = col + offsets[slot][1];
+        if (r >= 0 && r < board.height() && c >= 0 && c < board.width() && isOpen(board, r * board.width() + c)) {
+            mask |= 1u << slot;
+        }
+    }
+    return mask;
+}
+
+template <typename Topology>
+template <int Cells>
+void Solver<Topology>::lookUp(const BoardState& board, int row, int col, const int (&offsets)[Cells][2],
+                              quint32 entry, Deduction& result) {
+    ++counters.lookups;
+    counters.hits += entry != 0;
+    for (int slot = 0; entry != 0 && slot < Cells; ++slot) {
+        bool safe = entry & (1u << slot);
+        bool mine = entry & (1u << (slot + Cells));
+        if (!safe && !mine) {
+            continue;
+        }
+        int index = (row + offsets[slot][0]) * board.width() + col + offsets[slot][1];
+        if (!seen[index]) {
+            seen[index] = true;
+            (safe ? result.safe : result.mines).append(index);
+        }
+    }
+}
+
+// Searches the components that changed since they were last searched and reports the cells
+// still open from every cached result. Entries with nothing left to report are dropped.
+template <typename Topology>
+typename Solver<Topology>::Deduction Solver<Topology>::solveGeneral(const BasicBoard<Topology>& board) {
+    Deduction result;
+    for (auto it = cache.begin(); it != cache.end();) {
+        CachedComponent& entry = it.value();
+        if (!entry.solved) {
+            entry.result = solveComponent(board, entry.component);
+            entry.solved = true;
+        }
+        int found = result.safe.size() + result.mines.size();
+        for (int index : entry.result.safe) {
+            if (board.frontier().isUnknown(index)) {
+                result.safe.append(index);
+            }
+        }
+        for (int index : entry.result.mines) {
+            if (board.frontier().isUnknown(index)) {
+                result.mines.append(index);
+            }
+        }
+        if (result.safe.size() + result.mines.size() == found) {
+            forget(entry);
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return result;
+}
+
+// Enumerates the bomb layouts of a frontier component that satisfy all of its numbers.
+// Cells that are a bomb in no layout are safe, cells that are a bomb in every layout are bombs.
+template <typename Topology>
+typename Solver<Topology>::Deduction Solver<Topology>::solveComponent(const BasicBoard<Topology>& board,
+                                                                      const FrontierComponent& component) const {
+    Deduction result;
+    int unknownCount = component.unknowns.size();
+    if (unknownCount == 0 || unknownCount > MaxComponentUnknowns) {
+        return result;
+    }
+    QHash<int, int> local;   // Board index -> position in component.unknowns
+    for (int i = 0; i < unknownCount; ++i) {
+        local.insert(component.unknowns[i], i);
+    }
+
+    // Constraint c: the unknowns in cells[c] hold exactly need[c] bombs
+    QVector<QVector<int>> cells(component.numbers.size());
+    QVector<int> need(component.numbers.size());
+    QVector<QVector<int>> constraintsOf(unknownCount);
+    for (int c = 0; c < component.numbers.size(); ++c) {
+        int number = component.numbers[c];
+        need[c] = remaining(board, number);
+        board.forEachNeighbor(number, [&](int neighbor) {
+            int unknown = local.value(neighbor, -1);
+            if (unknown >= 0) {
+                cells[c].append(unknown);
+                constraintsOf[unknown].append(c);
+            }
+        });
+    }
+
+    // Depth-first search over the unknowns in order, pruning on every touched constraint
+    QVector<int> bombs(component.numbers.size(), 0);     // Bombs assigned per constraint
+    QVector<int> unassigned(component.numbers.size());   // Unknowns not yet assigned per constraint
+    for (int c = 0; c < cells.size(); ++c) {
+        unassigned[c] = cells[c].size();
+    }
+    QVector<qint8> assignment(unknownCount, -1);
+    QVector<quint64> bombCounts(unknownCount, 0);
+    quint64 layouts = 0;
+    int nodes = 0;
+    int depth = 0;
+    bool aborted = false;
+    while (depth >= 0) {
+        if (++nodes > MaxSearchNodes) {
+            aborted = true;
+            break;
+        }
+        if (depth == unknownCount) {
+            ++layouts;
+            for (int i = 0; i < unknownCount; ++i) {
+                bombCounts[i] += assignment[i];
+            }
+            --depth;
+            continue;
+        }
+        // Undo the current value of this unknown, then try the next one (-1 -> 0 -> 1 -> backtrack)
+        qint8 value = assignment[depth];
+        if (value >= 0) {
+            for (int c : constraintsOf[depth]) {
+                bombs[c] -= value;
+                ++unassigned[c];
+            }
+        }
+        if (value == 1) {
+            assignment[depth] = -1;
+            --depth;
+            continue;
+        }
+        value = qint8(value + 1);
+        assignment[depth] = value;
+        bool feasible = true;
+        for (int c : constraintsOf[depth]) {
+            bombs[c] += value;
+            --unassigned[c];
+            feasible = feasible && bombs[c] <= need[c] && bombs[c] + unassigned[c] >= need[c];
+        }
+        if (feasible) {
+            ++depth;
+        }
+    }
+    if (aborted || layouts == 0) {
+        return result;
+    }
+    for (int i = 0; i < unknownCount; ++i) {
+        if (bombCounts[i] == 0) {
+            result.safe.append(component.unknowns[i]);
+        } else if (bombCounts[i] == layouts) {
+            result.mines.append(component.unknowns[i]);
+        }
+    }
+    return result;
+}
+
+template <typename Topology>
+int Solver<Topology>::playOut(BasicBoard<Topology>& board, quint32 guessSeed) {
+    QRandomGenerator random(guessSeed);
+    int guesses = 0;
+    while (!board.isOver()) {
+        Deduction deduction = solve(board);
+        for (int index : deduction.mines) {
+            while (board.mark(index) != 1) {
+                board.toggleMark(index);
+            }
+        }
+        for (int index : deduction.safe) {
+            board.reveal(index);
+        }
+        if (!deduction.isEmpty()) {
+            continue;
+        }
+
+        // No certain move: reveal a random open cell
+        ++guesses;
+        int cellCount = board.cellCount();
+        int start = int(random.bounded(quint32(cellCount)));
+        int guess = -1;
+        for (int offset = 0; offset < cellCount && guess < 0; ++offset) {
+            int index = (start + offset) % cellCount;
+            if (isOpen(board, index)) {
+                guess = index;
+            }
+        }
+        if (guess < 0) {
+            break;   // Only flagged cells are left, so a flag must be wrong
+        }
+        board.reveal(guess);
+    }
+    return guesses;
+}
+
+#endif //MINE_SWEEPER_SOLVER_H
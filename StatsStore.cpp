@@ -0,0 +1,289 @@
+#include "StatsStore.h"
+#include <QDataStream>
+#include <QDir>
+#include <QSaveFile>
+#include <cstring>
+
+namespace {
+
+const qint64 MsPerDay = 24 * 60 * 60 * 1000;
+const quint32 IndexMagic = 0x4d535349;   // "MSSI"
+
+} // namespace
+
+// Outside the anonymous namespace so Qt's container operators find them by argument-dependent lookup
+static QDataStream& operator<<(QDataStream& stream, const StatsRecord& record) {
+    return stream << record.seed << record.maxLives << record.durationMs << record.clicks
+                  << record.bbbv << record.livesLost << record.won << record.finishedAt;
+}
+
+static QDataStream& operator>>(QDataStream& stream, StatsRecord& record) {
+    return stream >> record.seed >> record.maxLives >> record.durationMs >> record.clicks
+                  >> record.bbbv >> record.livesLost >> record.won >> record.finishedAt;
+}
+
+static QDataStream& operator<<(QDataStream& stream, const DayStats& day) {
+    return stream << day.day << day.games << day.wins;
+}
+
+static QDataStream& operator>>(QDataStream& stream, DayStats& day) {
+    return stream >> day.day >> day.games >> day.wins;
+}
+
+StatsStore::~StatsStore() {
+    close();
+}
+
+int StatsStore::columnWidth(int column) {
+    static const int widths[ColumnCount] = {4, 4, 4, 4, 4, 2, 1, 8};
+    return widths[column];
+}
+
+const char* StatsStore::columnName(int column) {
+    static const char* names[ColumnCount] = {"seed", "maxlives", "duration", "clicks",
+                                             "bbbv", "liveslost", "won", "finishedat"};
+    return names[column];
+}
+
+// Columns hold raw native-endian values, like the planes of a save file
+void StatsStore::storeField(int column, const StatsRecord& record, char* out) {
+    switch (column) {
+        case Seed: std::memcpy(out, &record.seed, 4); break;
+        case MaxLives: std::memcpy(out, &record.maxLives, 4); break;
+        case Duration: std::memcpy(out, &record.durationMs, 4); break;
+        case Clicks: std::memcpy(out, &record.clicks, 4); break;
+        case BBBV: std::memcpy(out, &record.bbbv, 4); break;
+        case LivesLost: std::memcpy(out, &record.livesLost, 2); break;
+        case Won: std::memcpy(out, &record.won, 1); break;
+        case FinishedAt: std::memcpy(out, &record.finishedAt, 8); break;
+    }
+}
+
+void StatsStore::loadField(int column, const char* in, StatsRecord& record) {
+    switch (column) {
+        case Seed: std::memcpy(&record.seed, in, 4); break;
+        case MaxLives: std::memcpy(&record.maxLives, in, 4); break;
+        case Duration: std::memcpy(&record.durationMs, in, 4); break;
+        case Clicks: std::memcpy(&record.clicks, in, 4); break;
+        case BBBV: std::memcpy(&record.bbbv, in, 4); break;
+        case LivesLost: std::memcpy(&record.livesLost, in, 2); break;
+        case Won: std::memcpy(&record.won, in, 1); break;
+        case FinishedAt: std::memcpy(&record.finishedAt, in, 8); break;
+    }
+}
+
+// Only the records appended after the index was last saved are read from the log
+bool StatsStore::open(const QString& path, QIODevice::OpenMode mode) {
+    close();
+    directory = path;
+    bool writable = mode & QIODevice::WriteOnly;
+    if (writable && !QDir().mkpath(directory)) {
+        return false;
+    }
+
+    records = -1;
+    for (int column = 0; column < ColumnCount; ++column) {
+        columns[column].setFileName(directory + "/" + columnName(column) + ".col");
+        if (!columns[column].open(writable ? QIODevice::ReadWrite : QIODevice::ReadOnly)) {
+            close();
+            return false;
+        }
+        qint64 count = columns[column].size() / columnWidth(column);
+        records = records < 0 ? count : qMin(records, count);
+    }
+    for (int column = 0; writable && column < ColumnCount; ++column) {
+        if (columns[column].size() != records * columnWidth(column)) {
+            columns[column].resize(records * columnWidth(column));
+        }
+    }
+
+    qint64 indexed = loadIndex();
+    if (indexed < 0 || indexed > records) {
+        index.clear();
+        indexed = 0;
+    }
+    // Catch up on games appended after the index was last written
+    const int batch = 65536;
+    for (qint64 first = indexed; first < records; first += batch) {
+        for (const StatsRecord& record : readRecords(first, batch)) {
+            addToIndex(record);
+        }
+        indexDirty = true;
+    }
+    if (indexDirty && writable) {
+        saveIndex();
+    }
+    return true;
+}
+
+void StatsStore::close() {
+    if (!isOpen()) {
+        return;
+    }
+    if (indexDirty && isWritable()) {
+        saveIndex();
+    }
+    for (QFile& column : columns) {
+        column.close();
+    }
+    index.clear();
+    records = 0;
+    indexDirty = false;
+}
+
+// Each column is flushed so a crash loses at most the record being written, and the index is
+// saved right away so the next open does not have to read the record back
+bool StatsStore::append(const StatsRecord& record) {
+    if (!isOpen() || !isWritable()) {
+        return false;
+    }
+    char value[8];
+    for (int column = 0; column < ColumnCount; ++column) {
+        int width = columnWidth(column);
+        storeField(column, record, value);
+        if (!columns[column].seek(records * width) || columns[column].write(value, width) != width
+            || !columns[column].flush()) {
+            return false;
+        }
+    }
+    ++records;
+    addToIndex(record);
+    indexDirty = true;
+    saveIndex();
+    return true;
+}
+
+// Reads one column at a time so each file is read sequentially
+QVector<StatsRecord> StatsStore::readRecords(qint64 first, int count) {
+    QVector<StatsRecord> result;
+    if (!isOpen() || first < 0 || first >= records || count <= 0) {
+        return result;
+    }
+    result.resize(int(qMin(qint64(count), records - first)));
+    QByteArray bytes;
+    for (int column = 0; column < ColumnCount; ++column) {
+        int width = columnWidth(column);
+        bytes.resize(result.size() * width);
+        if (!columns[column].seek(first * width) || columns[column].read(bytes.data(), bytes.size()) != bytes.size()) {
+            return QVector<StatsRecord>();
+        }
+        const char* in = bytes.constData();
+        for (StatsRecord& record : result) {
+            loadField(column, in, record);
+            in += width;
+        }
+    }
+    return result;
+}
+
+void StatsStore::addToIndex(const StatsRecord& record) {
+    DifficultyIndex& entry = index[record.maxLives];
+    ++entry.games;
+
+    DayStats& day = entry.days[record.finishedAt / MsPerDay];
+    day.day = record.finishedAt / MsPerDay;
+    ++day.games;
+
+    if (!record.won) {
+        return;
+    }
+    ++entry.wins;
+    ++day.wins;
+    if (entry.histogram.isEmpty()) {
+        entry.histogram.resize(HistogramBuckets);
+        entry.histogram.fill(0);
+    }
+    ++entry.histogram[qMin(int(record.durationMs / HistogramStepMs), HistogramBuckets - 1)];
+
+    // Insertion into the short sorted list of fastest wins; ties keep the earlier game first
+    int position = entry.best.size();
+    while (position > 0 && entry.best[position - 1].durationMs > record.durationMs) {
+        --position;
+    }
+    if (position < BestCount) {
+        entry.best.insert(position, record);
+        if (entry.best.size() > BestCount) {
+            entry.best.removeLast();
+        }
+    }
+}
+
+quint32 StatsStore::winDurationPercentile(int maxLives, double percentile) const {
+    auto found = index.find(maxLives);
+    if (found == index.end() || found->wins == 0) {
+        return 0;
+    }
+    const DifficultyIndex& entry = *found;
+    quint64 target = quint64(qBound(0.0, percentile, 100.0) / 100.0 * entry.wins + 0.5);
+    target = qMax<quint64>(target, 1);
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < entry.histogram.size(); ++bucket) {
+        seen += entry.histogram[bucket];
+        if (seen >= target) {
+            return quint32(bucket + 1) * HistogramStepMs;
+        }
+    }
+    return quint32(HistogramBuckets) * HistogramStepMs;
+}
+
+QVector<DayStats> StatsStore::winRateTrend(int maxLives, qint64 fromDay, qint64 toDay) const {
+    QVector<DayStats> result;
+    auto found = index.find(maxLives);
+    if (found == index.end()) {
+        return result;
+    }
+    const QMap<qint64, DayStats>& days = found->days;
+    for (auto day = days.lowerBound(fromDay); day != days.end() && day.key() <= toDay; ++day) {
+        result.append(day.value());
+    }
+    return result;
+}
+
+// The index is small, so it is rewritten whole and swapped in atomically
+bool StatsStore::saveIndex() {
+    QSaveFile file(directory + "/index.bin");
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << IndexMagic << IndexVersion << records << qint32(index.size());
+    for (auto entry = index.constBegin(); entry != index.constEnd(); ++entry) {
+        stream << qint32(entry.key()) << entry->games << entry->wins << entry->best
+               << entry->histogram << entry->days;
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        return false;
+    }
+    indexDirty = false;
+    return true;
+}
+
+qint64 StatsStore::loadIndex() {
+    QFile file(directory + "/index.bin");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 covered = 0;
+    qint32 count = 0;
+    stream >> magic >> version >> covered >> count;
+    if (magic != IndexMagic || version != IndexVersion || count < 0) {
+        return -1;
+    }
+    index.clear();
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        qint32 maxLives = 0;
+        DifficultyIndex entry;
+        stream >> maxLives >> entry.games >> entry.wins >> entry.best >> entry.histogram >> entry.days;
+        index.insert(maxLives, entry);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        index.clear();
+        return -1;
+    }
+    return covered;
+}
@@ -0,0 +1,161 @@
+#ifndef MINE_SWEEPER_STATSSTORE_H
+#define MINE_SWEEPER_STATSSTORE_H
+
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief One finished game as stored in the statistics log
+ */
+struct StatsRecord {
+    quint32 seed = 0;          // Seed used to place the bombs
+    qint32 maxLives = 0;       // Difficulty: lives at the start of the game
+    quint32 durationMs = 0;    // Time from the first click to the end of the game
+    quint32 clicks = 0;        // Reveals, chords and marks made by the player
+    quint32 bbbv = 0;          // 3BV: minimum number of clicks needed to clear the board
+    quint16 livesLost = 0;     // Lives lost during the game
+    quint8 won = 0;            // 1 if the board was cleared, 0 if the game was lost
+    qint64 finishedAt = 0;     // Milliseconds since the epoch when the game ended
+};
+
+/**
+ * @brief Games played and won on one day
+ */
+struct DayStats {
+    qint64 day = 0;        // Days since the epoch (UTC)
+    quint32 games = 0;
+    quint32 wins = 0;
+};
+
+/**
+ * @brief The StatsStore class keeps an append-only, columnar log of finished games
+ *
+ * Every field of StatsRecord lives in its own file of fixed-width values, so
+ * appending a game writes a few bytes to each column and scanning one field
+ * never reads the others. Per-difficulty aggregates (counts, best times, a
+ * duration histogram and daily win counts) are kept in memory and persisted to
+ * a small index file after every append, so opening the store reads the index
+ * and only the records a crash kept out of it. Queries are answered from the
+ * index alone.
+ */
+class StatsStore {
+public:
+    static const quint32 IndexVersion = 1;
+    static const int HistogramStepMs = 100;     // Width of a duration histogram bucket
+    static const int HistogramBuckets = 18000;  // 30 minutes; longer games share the last bucket
+    static const int BestCount = 10;            // Fastest wins kept per difficulty
+
+    StatsStore() = default;
+    StatsStore(const StatsStore&) = delete;
+    StatsStore& operator=(const StatsStore&) = delete;
+
+    /**
+     * @brief Writes the index if it changed and closes the log
+     */
+    ~StatsStore();
+
+    /**
+     * @brief Opens the log in a directory and brings the index up to date
+     * Opened for writing, the log is created if needed, columns left uneven by an interrupted
+     * append are cut back to the last whole record and a stale index is rewritten. Opened
+     * read-only, nothing on disk changes: uneven columns are read up to the last whole record
+     * and a stale index is only caught up in memory.
+     * @param directory Directory holding the column and index files
+     * @param mode QIODevice::ReadWrite, or QIODevice::ReadOnly to only query the log
+     * @return true if the log could be opened
+     */
+    bool open(const QString& directory, QIODevice::OpenMode mode = QIODevice::ReadWrite);
+
+    /**
+     * @brief Writes the index if it changed and closes the log
+     */
+    void close();
+
+    bool isOpen() const { return columns[0].isOpen(); }
+    bool isWritable() const { return columns[0].isWritable(); }
+
+    /**
+     * @brief Appends one game to the log and the index, then saves the index
+     * @return true if every column was written; an index that could not be saved is caught up on the next open
+     */
+    bool append(const StatsRecord& record);
+
+    /**
+     * @brief Number of games in the log
+     */
+    qint64 recordCount() const { return records; }
+
+    /**
+     * @brief Reads consecutive games back from the log
+     * @param first Number of the first record
+     * @param count Maximum number of records to read
+     * @return The records read, fewer than count at the end of the log
+     */
+    QVector<StatsRecord> readRecords(qint64 first, int count);
+
+    /**
+     * @brief The difficulties (maxLives values) with at least one recorded game
+     */
+    QList<int> difficulties() const { return index.keys(); }
+
+    quint32 games(int maxLives) const { return index.value(maxLives).games; }
+    quint32 wins(int maxLives) const { return index.value(maxLives).wins; }
+
+    /**
+     * @brief The fastest wins for a difficulty, fastest first
+     */
+    QVector<StatsRecord> bestTimes(int maxLives) const { return index.value(maxLives).best; }
+
+    /**
+     * @brief Duration below which the given share of wins finished
+     * @param percentile Between 0 and 100
+     * @return The duration in milliseconds, rounded up to a histogram bucket, or 0 without wins
+     */
+    quint32 winDurationPercentile(int maxLives, double percentile) const;
+
+    /**
+     * @brief Games and wins per day for a difficulty, oldest first
+     * @param fromDay First day to include, in days since the epoch
+     * @param toDay Last day to include
+     */
+    QVector<DayStats> winRateTrend(int maxLives, qint64 fromDay, qint64 toDay) const;
+
+private:
+    enum Column { Seed, MaxLives, Duration, Clicks, BBBV, LivesLost, Won, FinishedAt, ColumnCount };
+
+    /**
+     * @brief Aggregates over every recorded game of one difficulty
+     */
+    struct DifficultyIndex {
+        quint32 games = 0;
+        quint32 wins = 0;
+        QVector<StatsRecord> best;           // Fastest wins, fastest first
+        QVector<quint32> histogram;          // Wins per duration bucket
+        QMap<qint64, DayStats> days;         // Games and wins per day
+    };
+
+    QString directory;
+    QFile columns[ColumnCount];
+    QMap<int, DifficultyIndex> index;   // Keyed by maxLives
+    qint64 records = 0;                 // Whole records in the log, all covered by index
+    bool indexDirty = false;            // True while the index file lags behind the log
+
+    static int columnWidth(int column);
+    static const char* columnName(int column);
+    static void storeField(int column, const StatsRecord& record, char* out);
+    static void loadField(int column, const char* in, StatsRecord& record);
+
+    void addToIndex(const StatsRecord& record);
+
+    /**
+     * @brief Reads the index file
+     * @return The number of records the index covers, or -1 if it is missing or invalid
+     */
+    qint64 loadIndex();
+    bool saveIndex();
+};
+
+#endif //MINE_SWEEPER_STATSSTORE_H
@@ -0,0 +1,108 @@
+#ifndef MINE_SWEEPER_TOPOLOGY_H
+#define MINE_SWEEPER_TOPOLOGY_H
+
+/*
+ * Topology policies for BasicBoard.
+ *
+ * Each policy is a stateless struct with a static forEachNeighbor() that calls
+ * visit(neighborIndex) once per neighbor of a cell. The board engine is
+ * templated on the policy, so neighbor iteration is inlined into reveal and
+ * count loops with no adjacency tables and no per-cell dispatch.
+ * Cells are always indexed row * width + col.
+ */
+
+/**
+ * @brief The classic 8-cell square neighborhood, bounded by the grid edges
+ */
+struct SquareTopology {
+    static const int MaxNeighbors = 8;
+
+    template <typename Visit>
+    static void forEachNeighbor(int index, int width, int height, Visit&& visit) {
+        int row = index / width;
+        int col = index % width;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if (dr == 0 && dc == 0) continue;
+                int newRow = row + dr;
+                int newCol = col + dc;
+                if (newRow >= 0 && newRow < height && newCol >= 0 && newCol < width) {
+                    visit(newRow * width + newCol);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief The 8-cell square neighborhood with edges wrapping around (a torus)
+ * Boards must be at least 3x3 so that no cell is its own neighbor twice
+ */
+struct TorusTopology {
+    static const int MaxNeighbors = 8;
+
+    template <typename Visit>
+    static void forEachNeighbor(int index, int width, int height, Visit&& visit) {
+        int row = index / width;
+        int col = index % width;
+        for (int dr = -1; dr <= 1; ++dr) {
+            int newRow = row + dr < 0 ? height - 1 : row + dr == height ? 0 : row + dr;
+            for (int dc = -1; dc <= 1; ++dc) {
+                if (dr == 0 && dc == 0) continue;
+                int newCol = col + dc < 0 ? width - 1 : col + dc == width ? 0 : col + dc;
+                visit(newRow * width + newCol);
+            }
+        }
+    }
+};
+
+/**
+ * @brief A hexagonal grid in "odd-r" layout: odd rows are shifted half a cell to the right
+ * Each cell has up to 6 neighbors: two in its row and two in each adjacent row
+ */
+struct HexTopology {
+    static const int MaxNeighbors = 6;
+
+    template <typename Visit>
+    static void forEachNeighbor(int index, int width, int height, Visit&& visit) {
+        int row = index / width;
+        int col = index % width;
+        // Adjacent rows overlap columns (col - 1, col) on even rows and (col, col + 1) on odd rows
+        int shift = row & 1;
+        if (col > 0) visit(index - 1);
+        if (col + 1 < width) visit(index + 1);
+        for (int dr = -1; dr <= 1; dr += 2) {
+            int newRow = row + dr;
+            if (newRow < 0 || newRow >= height) continue;
+            for (int newCol = col - 1 + shift; newCol <= col + shift; ++newCol) {
+                if (newCol >= 0 && newCol < width) {
+                    visit(newRow * width + newCol);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Cells are neighbors when a chess knight can move between them
+ */
+struct KnightTopology {
+    static const int MaxNeighbors = 8;
+
+    template <typename Visit>
+    static void forEachNeighbor(int index, int width, int height, Visit&& visit) {
+        static const int moves[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+                                        {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        int row = index / width;
+        int col = index % width;
+        for (const auto& move : moves) {
+            int newRow = row + move[0];
+            int newCol = col + move[1];
+            if (newRow >= 0 && newRow < height && newCol >= 0 && newCol < width) {
+                visit(newRow * width + newCol);
+            }
+        }
+    }
+};
+
+#endif //MINE_SWEEPER_TOPOLOGY_H
@@ -0,0 +1,176 @@
+#include "TournamentView.h"
+#include "TournamentWorker.h"
+#include <QGuiApplication>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScreen>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Classic colors for the numbers 1-8
+const QRgb NumberColors[] = {0xff0000ff, 0xff008000, 0xffff0000, 0xff000080,
+                             0xff800000, 0xff008080, 0xff000000, 0xff808080};
+
+int gridColumns(int count) {
+    return int(std::ceil(std::sqrt(double(count))));
+}
+
+} // namespace
+
+// Runs the games on their own thread like the single-board window does
+TournamentView::TournamentView(int boardCount, int width, int height, int bombCount, int lives, QWidget *parent)
+    : QWidget(parent) {
+    boardCount = qBound(1, boardCount, int(MaxBoards));
+    setAttribute(Qt::WA_OpaquePaintEvent);   // Every pixel is painted, so skip clearing the background
+    buildAtlas();
+    tiles.resize(boardCount);
+
+    qRegisterMetaType<BoardDiff>("BoardDiff");
+    qRegisterMetaType<BoardSnapshot>("BoardSnapshot");
+    worker = new TournamentWorker;
+    worker->moveToThread(&workerThread);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(this, &TournamentView::startRequested, worker, &TournamentWorker::start);
+    connect(worker, &TournamentWorker::boardReady, this, &TournamentView::onBoardReady);
+    connect(worker, &TournamentWorker::boardChanged, this, &TournamentView::onBoardChanged);
+    workerThread.start();
+
+    // Start at one pixel per image pixel, shrunk to fit the screen
+    int columns = gridColumns(boardCount);
+    int rows = (boardCount + columns - 1) / columns;
+    QSize natural(columns * (width * TileSize + 4), rows * (height * TileSize + 4));
+    QRect screen = QGuiApplication::primaryScreen()->availableGeometry();
+    resize(natural.boundedTo(screen.size() * 9 / 10));
+
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&frameTimer, &QTimer::timeout, this, &TournamentView::flushFrame);
+    frameTimer.start(FrameIntervalMs);
+
+    emit startRequested(boardCount, width, height, bombCount, lives);
+}
+
+// Stops the worker thread; the worker itself is deleted when the thread finishes
+TournamentView::~TournamentView() {
+    workerThread.quit();
+    workerThread.wait();
+}
+
+// Uses the same colors as the single-board window: gray hidden cells, green revealed cells
+void TournamentView::buildAtlas() {
+    atlas = QImage((CellMine + 1) * TileSize, TileSize, QImage::Format_RGB32);
+    atlas.fill(Qt::black);
+    QPainter painter(&atlas);
+    painter.setPen(Qt::NoPen);
+    for (int view = 0; view <= CellMine; ++view) {
+        QRect cell(view * TileSize, 0, TileSize - 1, TileSize - 1);   // Leave a 1px grid line
+        QRect mark = cell.adjusted(2, 2, -2, -2);
+        if (view < CellHidden) {
+            painter.fillRect(cell, QColor("#00FF00"));
+            if (view > 0) {
+                painter.fillRect(mark, QColor::fromRgb(NumberColors[view - 1]));
+            }
+        } else if (view == CellMine) {
+            painter.fillRect(cell, Qt::red);
+            painter.setBrush(Qt::black);
+            painter.drawEllipse(mark);
+        } else {
+            painter.fillRect(cell, QColor("#c0c0c0"));
+            if (view == CellFlagged) {
+                painter.fillRect(mark, Qt::red);
+            } else if (view == CellQuestioned) {
+                painter.fillRect(mark, Qt::yellow);
+            }
+        }
+    }
+}
+
+// Copies tile rows straight into the image, which is cheaper than a QPainter per cell
+void TournamentView::drawCell(BoardTile& tile, int index, quint8 view) {
+    int x = (index % tile.width) * TileSize;
+    int y = (index / tile.width) * TileSize;
+    for (int row = 0; row < TileSize; ++row) {
+        const QRgb* source = reinterpret_cast<const QRgb*>(atlas.constScanLine(row)) + view * TileSize;
+        QRgb* target = reinterpret_cast<QRgb*>(tile.image.scanLine(y + row)) + x;
+        std::memcpy(target, source, TileSize * sizeof(QRgb));
+    }
+}
+
+// A new game replaces the whole image and drops changes queued for the old one
+void TournamentView::onBoardReady(int board, const BoardSnapshot& snapshot) {
+    BoardTile& tile = tiles[board];
+    bool resized = tile.width != snapshot.width || tile.image.height() != snapshot.height * TileSize;
+    if (resized) {
+        tile.image = QImage(snapshot.width * TileSize, snapshot.height * TileSize, QImage::Format_RGB32);
+        tile.width = snapshot.width;
+    }
+    for (int index = 0; index < snapshot.cells.size(); ++index) {
+        drawCell(tile, index, snapshot.cells[index]);
+    }
+    tile.pending.clear();
+    tile.outcome = MoveOutcome::None;
+    if (resized) {
+        layoutTiles();
+    }
+    update(tile.target.adjusted(-2, -2, 2, 2));
+}
+
+// Only queues the change; drawing waits for the next frame so bursts of moves cost one repaint
+void TournamentView::onBoardChanged(int board, const BoardDiff& diff) {
+    BoardTile& tile = tiles[board];
+    tile.pending += diff.cells;
+    if (diff.outcome != MoveOutcome::None) {
+        tile.outcome = diff.outcome;
+    }
+}
+
+void TournamentView::flushFrame() {
+    for (BoardTile& tile : tiles) {
+        if (tile.pending.isEmpty()) {
+            continue;
+        }
+        for (const CellChange& change : tile.pending) {
+            drawCell(tile, change.index, change.view);
+        }
+        tile.pending.clear();
+        update(tile.target.adjusted(-2, -2, 2, 2));
+    }
+}
+
+void TournamentView::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    layoutTiles();
+}
+
+// Every slot keeps the board's aspect ratio and is centered in its grid cell
+void TournamentView::layoutTiles() {
+    int columns = gridColumns(tiles.size());
+    int rows = (tiles.size() + columns - 1) / columns;
+    int slotWidth = width() / columns;
+    int slotHeight = height() / rows;
+    for (int board = 0; board < tiles.size(); ++board) {
+        BoardTile& tile = tiles[board];
+        QRect slot((board % columns) * slotWidth, (board / columns) * slotHeight, slotWidth, slotHeight);
+        QSize size = tile.image.isNull() ? QSize() : tile.image.size().scaled(slot.size() - QSize(4, 4), Qt::KeepAspectRatio);
+        tile.target = QRect(QPoint(0, 0), size);
+        tile.target.moveCenter(slot.center());
+    }
+    update();
+}
+
+// Draws only the boards inside the repainted region, framing finished games by result
+void TournamentView::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    painter.fillRect(event->rect(), Qt::black);
+    for (const BoardTile& tile : tiles) {
+        if (tile.image.isNull() || !event->region().intersects(tile.target.adjusted(-2, -2, 2, 2))) {
+            continue;
+        }
+        painter.drawImage(tile.target, tile.image);
+        if (tile.outcome == MoveOutcome::Won || tile.outcome == MoveOutcome::OutOfLives) {
+            painter.setPen(QPen(tile.outcome == MoveOutcome::Won ? Qt::yellow : Qt::red, 2));
+            painter.drawRect(tile.target.adjusted(-1, -1, 1, 1));
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef MINE_SWEEPER_TOURNAMENTVIEW_H
+#define MINE_SWEEPER_TOURNAMENTVIEW_H
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+#include <QThread>
+#include <QTimer>
+#include "BoardState.h"
+
+class TournamentWorker;
+
+/**
+ * @brief The TournamentView class shows many concurrent games as a mosaic of thumbnails
+ *
+ * Each board is cached as an image built from a shared atlas of cell tiles.
+ * Diffs from the worker are queued per board and applied once per frame, and
+ * only the boards that changed are repainted, all in a single paint pass.
+ */
+class TournamentView : public QWidget {
+Q_OBJECT
+
+public:
+    static const int MaxBoards = 64;          // Largest mosaic the view lays out
+    static const int TileSize = 8;            // Pixels per cell in the cached board images
+    static const int FrameIntervalMs = 16;    // About 60 frames per second
+
+    /**
+     * @brief Constructor for the tournament view, starts the games right away
+     * @param boardCount Number of boards to play, clamped to 1..MaxBoards
+     * @param width Width of each game grid
+     * @param height Height of each game grid
+     * @param bombCount Bombs on each board
+     * @param lives Number of lives for each game
+     * @param parent Parent widget (default is nullptr for main window)
+     */
+    TournamentView(int boardCount, int width, int height, int bombCount, int lives, QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor, stops the tournament worker thread
+     */
+    ~TournamentView() override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    /**
+     * @brief Rendering state of one board in the mosaic
+     */
+    struct BoardTile {
+        QImage image;                  // One atlas tile per cell
+        int width = 0;                 // Width of the game grid
+        QVector<CellChange> pending;   // Changes not yet drawn into image
+        MoveOutcome outcome = MoveOutcome::None;
+        QRect target;                  // Where the image is drawn in the widget
+    };
+
+    QImage atlas;                   // One tile per CellView value, side by side
+    QVector<BoardTile> tiles;
+    QThread workerThread;           // Thread running the games
+    TournamentWorker* worker;       // Game engine, lives on workerThread
+    QTimer frameTimer;              // Applies pending diffs once per frame
+
+    /**
+     * @brief Draws the tile of every CellView value into the atlas
+     */
+    void buildAtlas();
+
+    /**
+     * @brief Fits the boards into a grid of equally sized slots filling the widget
+     */
+    void layoutTiles();
+
+    /**
+     * @brief Copies the atlas tile for a view into a board image
+     */
+    void drawCell(BoardTile& tile, int index, quint8 view);
+
+private slots:
+    void onBoardReady(int board, const BoardSnapshot& snapshot);
+    void onBoardChanged(int board, const BoardDiff& diff);
+
+    /**
+     * @brief Draws the pending changes of every dirty board and schedules their repaint
+     */
+    void flushFrame();
+
+signals:
+    void startRequested(int boardCount, int width, int height, int bombCount, int lives);
+};
+
+#endif //MINE_SWEEPER_TOURNAMENTVIEW_H
@@ -0,0 +1,71 @@
+#include "TournamentWorker.h"
+#include <QRandomGenerator>
+#include <QTimer>
+
+TournamentWorker::TournamentWorker(QObject *parent) : QObject(parent) {
+}
+
+// The timer is created here so that it belongs to the worker thread
+void TournamentWorker::start(int boardCount, int width, int height, int bombCount, int lives) {
+    boardWidth = width;
+    boardHeight = height;
+    boardBombs = bombCount;
+    boardLives = lives;
+    boards.resize(boardCount);
+    idleRounds.resize(boardCount);
+    solvers.resize(boardCount);
+    for (int board = 0; board < boardCount; ++board) {
+        newBoard(board);
+    }
+
+    if (!roundTimer) {
+        roundTimer = new QTimer(this);
+        roundTimer->setTimerType(Qt::PreciseTimer);
+        connect(roundTimer, &QTimer::timeout, this, &TournamentWorker::playRound);
+    }
+    roundTimer->start(RoundIntervalMs);
+}
+
+void TournamentWorker::newBoard(int board) {
+    boards[board].generate(boardWidth, boardHeight, boardBombs, boardLives, QRandomGenerator::global()->generate());
+    idleRounds[board] = 0;
+    solvers[board] = Solver<SquareTopology>();
+    emit boardReady(board, boards[board].snapshot());
+}
+
+void TournamentWorker::playRound() {
+    for (int board = 0; board < boards.size(); ++board) {
+        if (boards[board].isOver()) {
+            if (++idleRounds[board] >= RestartDelayRounds) {
+                newBoard(board);
+            }
+            continue;
+        }
+        BoardDiff diff = playMove(boards[board], solvers[board]);
+        if (!diff.cells.isEmpty()) {
+            emit boardChanged(board, diff);
+        }
+    }
+}
+
+// Plays one proven cell per move so the boards animate cell by cell
+BoardDiff TournamentWorker::playMove(Board& board, Solver<SquareTopology>& solver) {
+    Solver<SquareTopology>::Deduction deduction = solver.solve(board);
+    if (!deduction.mines.isEmpty()) {
+        return board.toggleMark(deduction.mines.first());   // The bot never leaves question marks
+    }
+    if (!deduction.safe.isEmpty()) {
+        return board.reveal(deduction.safe.first());
+    }
+
+    // Nothing certain: reveal the first hidden, unmarked cell from a random starting point
+    int cellCount = board.cellCount();
+    int start = QRandomGenerator::global()->bounded(cellCount);
+    for (int offset = 0; offset < cellCount; ++offset) {
+        int index = (start + offset) % cellCount;
+        if (!board.isRevealed(index) && board.mark(index) == 0) {
+            return board.reveal(index);
+        }
+    }
+    return BoardDiff();
+}
@@ -0,0 +1,72 @@
+#ifndef MINE_SWEEPER_TOURNAMENTWORKER_H
+#define MINE_SWEEPER_TOURNAMENTWORKER_H
+
+#include <QObject>
+#include <QVector>
+#include "Board.h"
+#include "Solver.h"
+
+class QTimer;
+
+/**
+ * @brief The TournamentWorker class plays many boards at once with a simple built-in bot
+ * Every round each unfinished board gets one move, and finished boards are replaced
+ * after a short pause. Results are published as snapshots and diffs tagged with the board number.
+ */
+class TournamentWorker : public QObject {
+Q_OBJECT
+
+public:
+    static const int RoundIntervalMs = 16;    // Time between rounds of moves
+    static const int RestartDelayRounds = 90; // Rounds a finished board stays on screen
+
+    /**
+     * @brief Constructor for the tournament worker
+     * @param parent Parent object (must be nullptr to move the worker to another thread)
+     */
+    explicit TournamentWorker(QObject *parent = nullptr);
+
+public slots:
+    /**
+     * @brief Generates the boards, publishes their snapshots and starts playing
+     * @param boardCount Number of boards played at once
+     * @param width Width of each game grid
+     * @param height Height of each game grid
+     * @param bombCount Bombs on each board
+     * @param lives Number of lives for each game
+     */
+    void start(int boardCount, int width, int height, int bombCount, int lives);
+
+signals:
+    void boardReady(int board, const BoardSnapshot& snapshot);
+    void boardChanged(int board, const BoardDiff& diff);
+
+private slots:
+    /**
+     * @brief Plays one move on every unfinished board
+     */
+    void playRound();
+
+private:
+    QVector<Board> boards;      // Games in progress, only touched from the worker thread
+    QVector<int> idleRounds;    // Rounds since each board's game ended
+    QVector<Solver<SquareTopology>> solvers;   // One per board, as each caches its board's frontier
+    QTimer* roundTimer = nullptr;
+    int boardWidth = 0;
+    int boardHeight = 0;
+    int boardBombs = 0;
+    int boardLives = 0;
+
+    /**
+     * @brief Starts a fresh game on one board and publishes its snapshot
+     */
+    void newBoard(int board);
+
+    /**
+     * @brief Chooses and plays the bot's next move
+     * Flags or reveals a cell the solver proved, and otherwise reveals a random hidden cell
+     */
+    BoardDiff playMove(Board& board, Solver<SquareTopology>& solver);
+};
+
+#endif //MINE_SWEEPER_TOURNAMENTWORKER_H
@@ -1,8 +1,20 @@
 #include <QApplication>
+#include <QStandardPaths>
 #include <QDebug>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QDir>
+#include <cstdio>
 
 
 #include "Minesweeper.h"
+#include "TournamentView.h"
+#include "BoardStream.h"
+#include "StatsStore.h"
+#include "Solver.h"
+#include "BoardMetrics.h"
+#include <QElapsedTimer>
+#include <QTemporaryFile>
 /*
 // Create an object called Minesweeper that returns a QWidget
 class  Minesweeper : public QWidget{
@@ -358,14 +370,294 @@ private:
 };
  */
 
+// Settings a board can be generated from: a size the engine can index and at least one safe cell
+static bool validBoard(int width, int height, int mines) {
+    return BoardStream::validDimensions(width, height) && mines >= 0 && qint64(width) * height > mines;
+}
+
+// Generates a board and writes it for external tools, without starting the GUI
+static int exportBoard(const QString& path, int width, int height, int mines, quint32 seed) {
+    if (!validBoard(width, height, mines)) {
+        std::fprintf(stderr, "Invalid board dimensions\n");
+        return 1;
+    }
+
+    Board board;
+    board.generate(width, height, mines, 0, seed);
+
+    QFile file(path);
+    bool opened = path == "-" ? file.open(stdout, QIODevice::WriteOnly)
+                              : file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    if (!opened || !BoardStream::write(board, file, BoardStream::formatForPath(path))) {
+        std::fprintf(stderr, "Could not write %s\n", qPrintable(path));
+        return 1;
+    }
+    return 0;
+}
+
+// Plays the same seeded boards with and without the pattern tables and reports hit rate and speed.
+// Each game gets a fresh solver, as a solver caches the frontier of the board it plays.
+static int benchSolver(int games, int width, int height, int mines, quint32 seed) {
+    if (games <= 0 || !validBoard(width, height, mines)) {
+        std::fprintf(stderr, "Invalid benchmark settings\n");
+        return 1;
+    }
+    SolverPatterns::pairTable();   // Built on first use, which should not count against the first pass
+    qint64 baseline = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        bool patterns = pass == 0;
+        SolverStats stats;
+        int wins = 0;
+        int guesses = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int game = 0; game < games; ++game) {
+            Board board;
+            board.generate(width, height, mines, 0, seed + game);
+            Solver<SquareTopology> solver;
+            solver.setPatternsEnabled(patterns);
+            guesses += solver.playOut(board, ~(seed + game));
+            stats += solver.stats();
+            wins += board.isWon();   // playOut also stops early when only flagged cells are left
+        }
+        qint64 elapsed = timer.nsecsElapsed();
+        std::printf("%-12s %8.1f ms  %d/%d won  %d guesses", patterns ? "patterns" : "general only",
+                    elapsed / 1e6, wins, games, guesses);
+        if (patterns) {
+            baseline = elapsed;
+            std::printf("  hit rate %.1f%% of %llu lookups, %.1f%% of solves without the general solver\n",
+                        stats.lookups ? 100.0 * stats.hits / stats.lookups : 0.0, (unsigned long long)stats.lookups,
+                        100.0 * stats.patternSolves / qMax<quint64>(1, stats.patternSolves + stats.generalSolves));
+        } else {
+            std::printf("  speedup %.2fx\n", double(elapsed) / qMax<qint64>(1, baseline));
+        }
+    }
+    return 0;
+}
+
+// Writes a generated board to a temporary file in both formats and reads it back, reporting throughput
+static int benchStream(int width, int height, int mines, quint32 seed) {
+    if (!validBoard(width, height, mines)) {
+        std::fprintf(stderr, "Invalid board dimensions\n");
+        return 1;
+    }
+    Board board;
+    board.generate(width, height, mines, 0, seed);
+    for (BoardStream::Format format : {BoardStream::Format::Text, BoardStream::Format::Json}) {
+        QTemporaryFile file;
+        if (!file.open()) {
+            std::fprintf(stderr, "Could not create a temporary file\n");
+            return 1;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        bool written = BoardStream::write(board, file, format) && file.flush();
+        qint64 writeTime = timer.nsecsElapsed();
+        qint64 bytes = file.size();
+
+        Board loaded;
+        file.seek(0);
+        timer.restart();
+        bool read = written && BoardStream::read(loaded, file, format, 0);
+        qint64 readTime = timer.nsecsElapsed();
+        if (!read || loaded.bombTotal() != board.bombTotal()) {
+            std::fprintf(stderr, "Round trip failed\n");
+            return 1;
+        }
+        std::printf("%-5s %8.1f MB  write %8.1f MB/s  read %8.1f MB/s\n",
+                    format == BoardStream::Format::Json ? "json" : "text", bytes / 1e6,
+                    bytes / 1e6 / qMax(1e-9, writeTime / 1e9), bytes / 1e6 / qMax(1e-9, readTime / 1e9));
+    }
+    return 0;
+}
+
+// 3BV by flood-filling every opening, as a reference for BoardMetrics::measure()
+static quint32 floodFillBBBV(const Board& board) {
+    QVector<bool> covered(board.cellCount(), false);
+    QVector<int> stack;
+    quint32 clicks = 0;
+    for (int index = 0; index < board.cellCount(); ++index) {
+        if (covered[index] || board.isBomb(index) || board.adjacentBombs(index) != 0) {
+            continue;
+        }
+        ++clicks;
+        covered[index] = true;
+        stack.append(index);
+        while (!stack.isEmpty()) {
+            int cell = stack.takeLast();
+            board.forEachNeighbor(cell, [&](int neighbor) {
+                if (!covered[neighbor] && !board.isBomb(neighbor)) {
+                    covered[neighbor] = true;
+                    if (board.adjacentBombs(neighbor) == 0) {
+                        stack.append(neighbor);
+                    }
+                }
+            });
+        }
+    }
+    for (int index = 0; index < board.cellCount(); ++index) {
+        if (!covered[index] && !board.isBomb(index)) {
+            ++clicks;
+        }
+    }
+    return clicks;
+}
+
+// Times the single-pass metrics against a flood fill on one generated board, best of a few runs each
+static int benchMetrics(int width, int height, int mines, quint32 seed) {
+    if (!validBoard(width, height, mines)) {
+        std::fprintf(stderr, "Invalid board dimensions\n");
+        return 1;
+    }
+    const int runs = 3;
+    Board board;
+    board.generate(width, height, mines, 0, seed);
+    quint32 measured = 0;
+    quint32 flooded = 0;
+    qint64 measureTime = 0;
+    qint64 floodTime = 0;
+    for (int run = 0; run < runs; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+        measured = BoardMetrics::measure(board).bbbv;
+        qint64 elapsed = timer.nsecsElapsed();
+        measureTime = run == 0 ? elapsed : qMin(measureTime, elapsed);
+
+        timer.restart();
+        flooded = floodFillBBBV(board);
+        elapsed = timer.nsecsElapsed();
+        floodTime = run == 0 ? elapsed : qMin(floodTime, elapsed);
+    }
+    if (measured != flooded) {
+        std::fprintf(stderr, "3BV differs: %u measured, %u by flood fill\n", measured, flooded);
+        return 1;
+    }
+    std::printf("%lld cells, 3BV %u: single pass %.1f ms, flood fill %.1f ms, speedup %.2fx\n",
+                qint64(width) * height, measured, measureTime / 1e6, floodTime / 1e6,
+                double(floodTime) / qMax<qint64>(1, measureTime));
+    return 0;
+}
+
+static QString formatDuration(quint32 ms) {
+    return QString("%1:%2").arg(ms / 60000).arg((ms % 60000) / 1000.0, 4, 'f', 1, '0');
+}
+
+// Prints a summary per difficulty from the index, reading only games a crash kept out of it.
+// The log is opened read-only, so this is safe while a game is running.
+static int printStats(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);   // Names the data directory like the game does
+    StatsStore stats;
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/stats";
+    if (!QDir(directory).exists()) {
+        std::printf("No games recorded yet\n");
+        return 0;
+    }
+    if (!stats.open(directory, QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "Could not open %s\n", qPrintable(directory));
+        return 1;
+    }
+    for (int lives : stats.difficulties()) {
+        quint32 games = stats.games(lives);
+        quint32 wins = stats.wins(lives);
+        QVector<StatsRecord> best = stats.bestTimes(lives);
+        std::printf("%d lives: %u games, %u won (%.1f%%)", lives, games, wins, 100.0 * wins / games);
+        if (!best.isEmpty()) {
+            std::printf(", best %s, median %s, 90%% under %s",
+                        qPrintable(formatDuration(best.first().durationMs)),
+                        qPrintable(formatDuration(stats.winDurationPercentile(lives, 50))),
+                        qPrintable(formatDuration(stats.winDurationPercentile(lives, 90))));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
+    // Parse the command line before creating QApplication so exports run headless
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+    QCommandLineParser parser;
+    QCommandLineOption importOption("import", "Play the board in <file> (text or .json, - for stdin).", "file");
+    QCommandLineOption livesOption("lives", "Lives for an imported or watched board.", "n", "0");
+    QCommandLineOption exportOption("export", "Write a generated board to <file> (text or .json, - for stdout) and exit.", "file");
+    QCommandLineOption watchOption("watch", "Watch <n> bot games at once (up to 64).", "n");
+    QCommandLineOption widthOption("width", "Width of an exported or watched board.", "n", "30");
+    QCommandLineOption heightOption("height", "Height of an exported or watched board.", "n", "16");
+    QCommandLineOption minesOption("mines", "Bombs in an exported or watched board.", "n", "99");
+    QCommandLineOption seedOption("seed", "Seed for an exported or benchmarked board.", "n", "0");
+    QCommandLineOption statsOption("stats", "Print statistics of finished games and exit.");
+    QCommandLineOption benchOption("bench-solver", "Let the solver play <n> seeded boards with and without its pattern tables and exit.", "n");
+    QCommandLineOption benchStreamOption("bench-stream", "Write and read back a generated board in both formats, print MB/s and exit.");
+    QCommandLineOption benchMetricsOption("bench-metrics", "Time the board metrics against a flood fill on a generated board and exit.");
+    parser.addOptions({importOption, livesOption, exportOption, watchOption, widthOption, heightOption, minesOption, seedOption, statsOption, benchOption,
+                       benchStreamOption, benchMetricsOption});
+    if (!parser.parse(arguments)) {
+        std::fprintf(stderr, "%s\n", qPrintable(parser.errorText()));
+        return 1;
+    }
+
+    if (parser.isSet(exportOption)) {
+        return exportBoard(parser.value(exportOption),
+                           parser.value(widthOption).toInt(),
+                           parser.value(heightOption).toInt(),
+                           parser.value(minesOption).toInt(),
+                           parser.value(seedOption).toUInt());
+    }
+
+    if (parser.isSet(benchOption)) {
+        return benchSolver(parser.value(benchOption).toInt(),
+                           parser.value(widthOption).toInt(),
+                           parser.value(heightOption).toInt(),
+                           parser.value(minesOption).toInt(),
+                           parser.value(seedOption).toUInt());
+    }
+
+    if (parser.isSet(benchStreamOption)) {
+        return benchStream(parser.value(widthOption).toInt(),
+                           parser.value(heightOption).toInt(),
+                           parser.value(minesOption).toInt(),
+                           parser.value(seedOption).toUInt());
+    }
+
+    if (parser.isSet(benchMetricsOption)) {
+        return benchMetrics(parser.value(widthOption).toInt(),
+                            parser.value(heightOption).toInt(),
+                            parser.value(minesOption).toInt(),
+                            parser.value(seedOption).toUInt());
+    }
+
+    if (parser.isSet(statsOption)) {
+        return printStats(argc, argv);
+    }
+
     // Create instance of QApplication
     QApplication app(argc, argv);
 
+    // Show a mosaic of bot games instead of the playable window
+    if (parser.isSet(watchOption)) {
+        int width = parser.value(widthOption).toInt();
+        int height = parser.value(heightOption).toInt();
+        int mines = parser.value(minesOption).toInt();
+        if (!validBoard(width, height, mines)) {
+            std::fprintf(stderr, "Invalid board dimensions\n");
+            return 1;
+        }
+        TournamentView view(parser.value(watchOption).toInt(), width, height, mines, parser.value(livesOption).toInt());
+        view.setWindowTitle("Minesweeper Tournament");
+        view.show();
+        return app.exec();
+    }
+
     // Create instance of Minesweeper clas
     Minesweeper game;
     // Set title of the window
     game.setWindowTitle("Minesweeper");
+    // Start straight on an imported board if one was given
+    if (parser.isSet(importOption)) {
+        game.importGame(parser.value(importOption), parser.value(livesOption).toInt());
+    }
     // show the window
     game.show();
 
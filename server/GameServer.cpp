@@ -0,0 +1,139 @@
+#include "GameServer.h"
+#include <QLocalSocket>
+#include <QSocketNotifier>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+GameServer::GameServer(QObject *parent) : QObject(parent) {
+    server.setMaxPendingConnections(1024);
+    connect(&server, &QLocalServer::newConnection, this, &GameServer::acceptClients);
+}
+
+GameServer::~GameServer() {
+    qDeleteAll(sessions);
+    // stdout may share its file description with the terminal, which expects blocking writes again
+    if (stdoutFlags >= 0) {
+        ::fcntl(STDOUT_FILENO, F_SETFL, stdoutFlags);
+    }
+}
+
+bool GameServer::listen(const QString& path) {
+    QLocalServer::removeServer(path);
+    return server.listen(path);
+}
+
+void GameServer::serveStdio() {
+    stdoutFlags = ::fcntl(STDOUT_FILENO, F_GETFL);
+    if (stdoutFlags >= 0) {
+        ::fcntl(STDOUT_FILENO, F_SETFL, stdoutFlags | O_NONBLOCK);
+    }
+    stdinNotifier = new QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read, this);
+    connect(stdinNotifier, &QSocketNotifier::activated, this, &GameServer::readStdin);
+    stdoutNotifier = new QSocketNotifier(STDOUT_FILENO, QSocketNotifier::Write, this);
+    stdoutNotifier->setEnabled(false);
+    connect(stdoutNotifier, &QSocketNotifier::activated, this, &GameServer::flushStdout);
+}
+
+void GameServer::acceptClients() {
+    while (QLocalSocket* socket = server.nextPendingConnection()) {
+        sessions.insert(socket, new GameSession);
+        // Unread requests then wait in the kernel's socket buffer instead of ours
+        socket->setReadBufferSize(MaxLineBytes);
+        connect(socket, &QLocalSocket::readyRead, this, &GameServer::readClient);
+        connect(socket, &QLocalSocket::bytesWritten, this, &GameServer::readClient);
+        connect(socket, &QLocalSocket::disconnected, this, &GameServer::dropClient);
+    }
+}
+
+// Answers every complete line that arrived, then sends all replies in one write. Reading stops
+// while more than MaxLineBytes of replies wait for the client, and resumes once it takes them.
+void GameServer::readClient() {
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    GameSession* session = sessions.value(socket);
+    if (!session) {
+        return;
+    }
+    QByteArray reply;
+    while (socket->bytesToWrite() + reply.size() <= MaxLineBytes && socket->canReadLine()) {
+        reply += session->handleLine(socket->readLine());
+    }
+    if (!reply.isEmpty()) {
+        socket->write(reply);
+    }
+    // A client that never ends its line would otherwise stall with a full buffer forever
+    if (!socket->canReadLine() && socket->bytesAvailable() >= MaxLineBytes) {
+        socket->abort();
+    }
+}
+
+void GameServer::dropClient() {
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    delete sessions.take(socket);
+    socket->deleteLater();
+}
+
+// Reads whatever is available without blocking; the notifier only fires when input is ready
+void GameServer::readStdin() {
+    char buffer[65536];
+    ssize_t count = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return;   // stdin shares the non-blocking flag when it is the same terminal or socket as stdout
+    }
+    if (count <= 0) {
+        // A last command without a trailing newline is still answered
+        stdinNotifier->setEnabled(false);
+        stdinClosed = true;
+        QByteArray reply;
+        if (!stdinBuffer.isEmpty()) {
+            reply = stdioSession.handleLine(stdinBuffer);
+            stdinBuffer.clear();
+        }
+        writeStdout(reply);
+        return;
+    }
+    stdinBuffer.append(buffer, int(count));
+
+    QByteArray reply;
+    int start = 0;
+    int end;
+    while ((end = stdinBuffer.indexOf('\n', start)) >= 0) {
+        reply += stdioSession.handleLine(stdinBuffer.mid(start, end - start));
+        start = end + 1;
+    }
+    stdinBuffer.remove(0, start);
+    if (stdinBuffer.size() > MaxLineBytes) {
+        stdinBuffer.clear();
+        reply += "err - line too long\n";
+    }
+
+    writeStdout(reply);
+}
+
+void GameServer::writeStdout(const QByteArray& reply) {
+    stdoutBuffer += reply;
+    flushStdout();
+}
+
+// Called again by the write notifier until the queue is empty. Stdin is not read while more than
+// MaxLineBytes wait, so a client that stops reading its replies only queues the answers to one read.
+void GameServer::flushStdout() {
+    while (!stdoutBuffer.isEmpty()) {
+        ssize_t count = ::write(STDOUT_FILENO, stdoutBuffer.constData(), size_t(stdoutBuffer.size()));
+        if (count > 0) {
+            stdoutBuffer.remove(0, int(count));
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            stdoutBuffer.clear();   // Nobody reads the replies any more
+        }
+    }
+    stdoutNotifier->setEnabled(!stdoutBuffer.isEmpty());
+    if (!stdinClosed) {
+        stdinNotifier->setEnabled(stdoutBuffer.size() <= MaxLineBytes);
+    } else if (stdoutBuffer.isEmpty()) {
+        emit stdioClosed();
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef MINE_SWEEPER_GAMESERVER_H
+#define MINE_SWEEPER_GAMESERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QLocalServer>
+#include "GameSession.h"
+
+class QLocalSocket;
+class QSocketNotifier;
+
+/**
+ * @brief The GameServer class serves the bot protocol over standard input/output and a Unix socket
+ * Every client gets its own GameSession. All clients are multiplexed on the
+ * single thread's event loop, so no game state is ever shared between threads.
+ */
+class GameServer : public QObject {
+Q_OBJECT
+
+public:
+    static const int MaxLineBytes = 1 << 20;   // Longest request a client may send
+
+    explicit GameServer(QObject *parent = nullptr);
+    ~GameServer() override;
+
+    /**
+     * @brief Accepts clients on a Unix domain socket, replacing a stale socket file
+     * @param path Path of the socket
+     * @return false if the socket could not be created
+     */
+    bool listen(const QString& path);
+
+    /**
+     * @brief Serves one client on standard input and standard output
+     * Standard output is switched to non-blocking mode, so a slow reader never stalls the other clients
+     */
+    void serveStdio();
+
+signals:
+    /**
+     * @brief Emitted once standard input reached end of file and every reply was written
+     */
+    void stdioClosed();
+
+private slots:
+    void acceptClients();
+    void readClient();
+    void dropClient();
+    void readStdin();
+    void flushStdout();
+
+private:
+    QLocalServer server;
+    QHash<QLocalSocket*, GameSession*> sessions;   // Owned, one per connected client
+    GameSession stdioSession;
+    QSocketNotifier* stdinNotifier = nullptr;
+    QSocketNotifier* stdoutNotifier = nullptr;   // Enabled while replies wait for stdout to take them
+    QByteArray stdinBuffer;    // Bytes read from stdin that do not form a full line yet
+    QByteArray stdoutBuffer;   // Replies not yet written to stdout
+    bool stdinClosed = false;
+    int stdoutFlags = -1;      // File status flags of stdout before serveStdio(), restored on destruction
+
+    /**
+     * @brief Queues replies for stdout and writes as much as it takes without blocking
+     */
+    void writeStdout(const QByteArray& reply);
+};
+
+#endif //MINE_SWEEPER_GAMESERVER_H
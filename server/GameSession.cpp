@@ -0,0 +1,173 @@
+#include "GameSession.h"
+#include <QRandomGenerator>
+
+namespace {
+
+// One printable character per CellView value
+const char ViewChars[] = "012345678#F?*";
+
+const char* outcomeName(MoveOutcome outcome) {
+    switch (outcome) {
+        case MoveOutcome::HitMine: return "hit";
+        case MoveOutcome::OutOfLives: return "lost";
+        case MoveOutcome::Won: return "won";
+        default: return "ok";
+    }
+}
+
+void appendError(const QByteArray& id, const char* reason, QByteArray& reply) {
+    reply += "err ";
+    reply += id.isEmpty() ? QByteArray("-") : id;
+    reply += ' ';
+    reply += reason;
+}
+
+} // namespace
+
+GameSession::~GameSession() {
+    qDeleteAll(games);
+}
+
+// Replies are built into one buffer so a whole batch goes out in a single write
+QByteArray GameSession::handleLine(const QByteArray& line) {
+    QByteArray reply;
+    for (const QByteArray& command : line.split(';')) {
+        QByteArray trimmed = command.simplified();
+        if (trimmed.isEmpty()) {
+            continue;
+        }
+        handleCommand(trimmed.split(' '), reply);
+        reply += '\n';
+    }
+    return reply;
+}
+
+void GameSession::handleCommand(const QList<QByteArray>& args, QByteArray& reply) {
+    const QByteArray& name = args[0];
+    QByteArray id = args.value(1);
+    if (name == "new") {
+        newGame(args, reply);
+        return;
+    }
+
+    ServerGame* game = games.value(id);
+    if (!game) {
+        appendError(id, "unknown game", reply);
+        return;
+    }
+    const BoardState& state = game->state();
+
+    if (name == "end") {
+        openCells -= state.cellCount();
+        delete games.take(id);
+        reply += id;
+        reply += " end";
+        return;
+    } else if (name == "v") {
+        appendView(id, state, reply);
+        return;
+    } else if (name == "u") {
+        appendDiff(id, game->undo(), reply);
+        return;
+    }
+
+    bool ok = false;
+    int index = args.value(2).toInt(&ok);
+    if (!ok || index < 0 || index >= state.cellCount()) {
+        appendError(id, "bad index", reply);
+        return;
+    }
+    if (state.isOver()) {
+        appendError(id, "game over", reply);
+        return;
+    }
+
+    if (name == "r") {
+        appendDiff(id, game->reveal(index), reply);
+    } else if (name == "c") {
+        appendDiff(id, game->chord(index), reply);
+    } else if (name == "m") {
+        appendDiff(id, game->toggleMark(index), reply);
+    } else {
+        appendError(id, "unknown command", reply);
+    }
+}
+
+// Validates the settings before generating, since placeBombs() needs a free cell for every bomb
+void GameSession::newGame(const QList<QByteArray>& args, QByteArray& reply) {
+    QByteArray id = args.value(1);
+    bool widthOk = false, heightOk = false, minesOk = false, livesOk = true, seedOk = true;
+    int width = args.value(2).toInt(&widthOk);
+    int height = args.value(3).toInt(&heightOk);
+    int mines = args.value(4).toInt(&minesOk);
+    int lives = args.size() > 5 ? args[5].toInt(&livesOk) : 0;
+    quint32 seed = args.size() > 6 ? args[6].toUInt(&seedOk) : QRandomGenerator::global()->generate();
+    QByteArray topology = args.value(7, "square");
+
+    if (id.isEmpty() || !widthOk || !heightOk || !minesOk || !livesOk || !seedOk) {
+        appendError(id, "bad arguments", reply);
+        return;
+    }
+    if (width <= 0 || height <= 0 || qint64(width) * height > MaxCells || mines < 0
+        || mines >= width * height || lives < 0) {
+        appendError(id, "bad dimensions", reply);
+        return;
+    }
+    if (topology == "torus" && (width < 3 || height < 3)) {
+        appendError(id, "torus needs 3x3", reply);
+        return;
+    }
+
+    // A game replaced under the same id gives its cells back
+    ServerGame* previous = games.value(id);
+    qint64 remainingCells = openCells - (previous ? previous->state().cellCount() : 0);
+    if (!previous && games.size() >= MaxGames) {
+        appendError(id, "too many games", reply);
+        return;
+    }
+    if (remainingCells + qint64(width) * height > MaxSessionCells) {
+        appendError(id, "too many cells", reply);
+        return;
+    }
+
+    ServerGame* game = ServerGame::create(topology, width, height, mines, lives, seed);
+    if (!game) {
+        appendError(id, "unknown topology", reply);
+        return;
+    }
+    delete previous;
+    games.insert(id, game);
+    openCells = remainingCells + game->state().cellCount();
+
+    reply += id;
+    reply += " new ";
+    reply += QByteArray::number(width) + ' ' + QByteArray::number(height) + ' ' + QByteArray::number(mines)
+             + ' ' + QByteArray::number(lives) + ' ' + QByteArray::number(seed);
+}
+
+void GameSession::appendDiff(const QByteArray& id, const BoardDiff& diff, QByteArray& reply) const {
+    reply += id;
+    reply += ' ';
+    reply += outcomeName(diff.outcome);
+    reply += ' ';
+    reply += QByteArray::number(diff.lives);
+    for (const CellChange& change : diff.cells) {
+        reply += ' ';
+        reply += QByteArray::number(change.index);
+        reply += ':';
+        reply += ViewChars[change.view];
+    }
+}
+
+void GameSession::appendView(const QByteArray& id, const BoardState& state, QByteArray& reply) const {
+    reply += id;
+    reply += " view ";
+    reply += QByteArray::number(state.width()) + ' ' + QByteArray::number(state.height()) + ' '
+             + QByteArray::number(state.lives()) + ' ';
+    int start = reply.size();
+    reply.resize(start + state.cellCount());
+    char* out = reply.data() + start;
+    for (int index = 0; index < state.cellCount(); ++index) {
+        out[index] = ViewChars[state.cellView(index)];
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef MINE_SWEEPER_GAMESESSION_H
+#define MINE_SWEEPER_GAMESESSION_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include "ServerGame.h"
+
+/**
+ * @brief The GameSession class runs the bot protocol for one client
+ *
+ * A request is one line holding a batch of commands separated by ';'. The reply
+ * holds one line per command, in order:
+ *
+ *   new <id> <width> <height> <mines> [lives] [seed] [topology]
+ *       -> <id> new <width> <height> <mines> <lives> <seed>
+ *   r <id> <index>    reveal          -> <id> <outcome> <lives> <index>:<view>...
+ *   c <id> <index>    chord           -> same as r
+ *   m <id> <index>    cycle the mark  -> same as r
+ *   u <id>            undo            -> same as r
+ *   v <id>            view the board  -> <id> view <width> <height> <lives> <one view per cell>
+ *   end <id>          drop the game   -> <id> end
+ *
+ * Outcomes are ok, hit, lost and won; views are 0-8, # (hidden), F (flag),
+ * ? (question mark) and * (mine). Moves only list the cells they changed.
+ * Errors reply "err <id> <reason>" and leave the rest of the batch running.
+ * Game ids are chosen by the client and are private to the session. A session
+ * holds at most MaxGames games of MaxSessionCells cells in total; end frees both.
+ */
+class GameSession {
+public:
+    GameSession() = default;
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+    ~GameSession();
+
+    static const int MaxCells = 1 << 24;             // Largest board a client may create
+    static const int MaxGames = 1 << 16;             // Most games a client may keep open at once
+    static const qint64 MaxSessionCells = 1 << 26;   // Most cells over all open games of a client
+
+    /**
+     * @brief Runs every command of one request line
+     * @param line The request, with or without its trailing newline
+     * @return The reply lines, each ending in a newline
+     */
+    QByteArray handleLine(const QByteArray& line);
+
+    int gameCount() const { return games.size(); }
+
+private:
+    QHash<QByteArray, ServerGame*> games;   // Owned, keyed by client game id
+    qint64 openCells = 0;                   // Cells over all games, at most MaxSessionCells
+
+    void handleCommand(const QList<QByteArray>& args, QByteArray& reply);
+    void newGame(const QList<QByteArray>& args, QByteArray& reply);
+    void appendDiff(const QByteArray& id, const BoardDiff& diff, QByteArray& reply) const;
+    void appendView(const QByteArray& id, const BoardState& state, QByteArray& reply) const;
+};
+
+#endif //MINE_SWEEPER_GAMESESSION_H
@@ -0,0 +1,28 @@
+# Headless engine for bots, built from the same board sources as the game
+TEMPLATE = app
+TARGET = MinesweeperServer
+CONFIG += console    # No GUI, talks over stdin/stdout and a Unix socket
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+# Define the source files
+SOURCES += main.cpp \
+           GameServer.cpp \
+           GameSession.cpp \
+           ../BoardState.cpp \
+           ../Journal.cpp
+
+# Define the header files
+HEADERS += GameServer.h \
+           GameSession.h \
+           ServerGame.h \
+           ../Board.h \
+           ../BoardState.h \
+           ../Frontier.h \
+           ../Journal.h \
+           ../Topology.h
+
+# Include additional Qt modules
+QT -= gui
+QT += network         # QLocalServer for the Unix socket
@@ -0,0 +1,65 @@
+#ifndef MINE_SWEEPER_SERVERGAME_H
+#define MINE_SWEEPER_SERVERGAME_H
+
+#include <QByteArray>
+#include "Board.h"
+
+/**
+ * @brief One game hosted by the server, independent of its topology
+ * The virtual call happens once per command; every neighbor walk below it is
+ * the inlined topology code of BasicBoard
+ */
+class ServerGame {
+public:
+    virtual ~ServerGame() = default;
+
+    virtual BoardDiff reveal(int index) = 0;
+    virtual BoardDiff chord(int index) = 0;
+    virtual BoardDiff toggleMark(int index) = 0;
+    virtual BoardDiff undo() = 0;
+    virtual const BoardState& state() const = 0;
+
+    /**
+     * @brief Creates a game on a freshly generated board
+     * @param topology "square", "torus", "hex" or "knight"
+     * @return A new game owned by the caller, nullptr if the topology name is unknown
+     */
+    static ServerGame* create(const QByteArray& topology, int width, int height,
+                                              int bombCount, int lives, quint32 seed);
+};
+
+/**
+ * @brief ServerGame backed by a board of one topology
+ */
+template <typename Topology>
+class TopologyGame : public ServerGame {
+public:
+    TopologyGame(int width, int height, int bombCount, int lives, quint32 seed) {
+        board.generate(width, height, bombCount, lives, seed);
+    }
+
+    BoardDiff reveal(int index) override { return board.reveal(index); }
+    BoardDiff chord(int index) override { return board.chord(index); }
+    BoardDiff toggleMark(int index) override { return board.toggleMark(index); }
+    BoardDiff undo() override { return board.undo(); }
+    const BoardState& state() const override { return board; }
+
+private:
+    BasicBoard<Topology> board;
+};
+
+inline ServerGame* ServerGame::create(const QByteArray& topology, int width, int height,
+                                      int bombCount, int lives, quint32 seed) {
+    if (topology == "square") {
+        return new TopologyGame<SquareTopology>(width, height, bombCount, lives, seed);
+    } else if (topology == "torus") {
+        return new TopologyGame<TorusTopology>(width, height, bombCount, lives, seed);
+    } else if (topology == "hex") {
+        return new TopologyGame<HexTopology>(width, height, bombCount, lives, seed);
+    } else if (topology == "knight") {
+        return new TopologyGame<KnightTopology>(width, height, bombCount, lives, seed);
+    }
+    return nullptr;
+}
+
+#endif //MINE_SWEEPER_SERVERGAME_H
@@ -0,0 +1,37 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <csignal>
+#include <cstdio>
+
+#include "GameServer.h"
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("MinesweeperServer");
+    // A client that hangs up must surface as a failed write, not kill every other client's games
+    std::signal(SIGPIPE, SIG_IGN);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless Minesweeper engine for bots. See GameSession.h for the protocol.");
+    parser.addHelpOption();
+    QCommandLineOption socketOption("socket", "Accept clients on the Unix socket <path>.", "path");
+    QCommandLineOption stdioOption("stdio", "Also serve standard input/output when --socket is given.");
+    parser.addOptions({socketOption, stdioOption});
+    parser.process(app);
+
+    GameServer server;
+    bool useSocket = parser.isSet(socketOption);
+    if (useSocket && !server.listen(parser.value(socketOption))) {
+        std::fprintf(stderr, "Could not listen on %s\n", qPrintable(parser.value(socketOption)));
+        return 1;
+    }
+    if (!useSocket || parser.isSet(stdioOption)) {
+        server.serveStdio();
+        // Without a socket there is nothing left to serve once stdin closes
+        if (!useSocket) {
+            QObject::connect(&server, &GameServer::stdioClosed, &app, &QCoreApplication::quit);
+        }
+    }
+
+    return app.exec();
+}